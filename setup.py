@@ -1,4 +1,5 @@
-from setuptools import setup, Extension
+from setuptools import setup, Extension, Command
+import os
 import platform
 
 extra_compile_args = []
@@ -6,15 +7,54 @@ extra_link_args = []
 
 if platform.system() != 'Windows':
     extra_compile_args = ['-pthread', '-O3']
-    extra_link_args = ['-pthread']
+    extra_link_args = ['-pthread', '-lm']
+
+engine_sources = ['src/cpu_loader/cpu_loader_engine.c']
 
 module = Extension(
     'cpu_loader.cpu_loader_core',
-    sources=['src/cpu_loader/cpu_loader_core.c'],
+    sources=['src/cpu_loader/cpu_loader_core.c'] + engine_sources,
     extra_compile_args=extra_compile_args,
     extra_link_args=extra_link_args,
 )
 
+
+class BuildBench(Command):
+    """Build the native engine benchmark, cpu-loader-engine-bench."""
+
+    description = 'build the native engine benchmark executable'
+    user_options = [
+        ('build-dir=', 'b', 'directory for the executable (default: build)'),
+    ]
+
+    def initialize_options(self):
+        self.build_dir = None
+
+    def finalize_options(self):
+        if self.build_dir is None:
+            self.build_dir = 'build'
+
+    def run(self):
+        # Imported here, setuptools provides distutils on Python 3.12+
+        from distutils.ccompiler import new_compiler
+        from distutils.sysconfig import customize_compiler
+
+        compiler = new_compiler()
+        customize_compiler(compiler)
+        objects = compiler.compile(
+            ['src/cpu_loader/cpu_loader_bench.c'] + engine_sources,
+            output_dir=os.path.join(self.build_dir, 'bench'),
+            extra_postargs=extra_compile_args,
+        )
+        compiler.link_executable(
+            objects,
+            'cpu-loader-engine-bench',
+            output_dir=self.build_dir,
+            extra_postargs=extra_link_args,
+        )
+
+
 setup(
     ext_modules=[module],
+    cmdclass={'build_bench': BuildBench},
 )
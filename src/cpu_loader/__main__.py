@@ -1,6 +1,19 @@
 """Main entry point for CPU Loader application."""
 
-from cpu_loader.main import run
+import sys
+
+
+def run():
+    """Run the benchmark suite for 'cpu-loader bench', the server otherwise."""
+    if len(sys.argv) > 1 and sys.argv[1] == "bench":
+        from cpu_loader.bench import main
+
+        sys.exit(main(sys.argv[2:]))
+
+    from cpu_loader.main import run as run_server
+
+    run_server()
+
 
 if __name__ == "__main__":
     run()
@@ -0,0 +1,384 @@
+"""
+Kernel Benchmark Module
+Runs every computation kernel at 100% load at 1, 2, 4, ... N threads and
+records throughput per thread and in aggregate, for quick host qualification.
+"""
+
+import argparse
+import importlib
+import json
+import multiprocessing
+import statistics
+import sys
+import time
+from datetime import datetime, timezone
+from typing import Any, Dict, List, Optional, Sequence
+
+from cpu_loader.cpu_loader import ComputationType, CPULoader
+from cpu_loader.scalability import fit_results, format_fit_table
+from cpu_loader.sensors import read_host_metadata
+
+# Version 2 added host metadata and the per-point noise (ops_per_sec_cv),
+# version 3 the effective clock (effective_mhz, frequency_ratio)
+SCHEMA_VERSION = 3
+DEFAULT_OUTPUT = "cpu-loader-bench.json"
+
+# Benchmarks of their own modules, run as 'cpu-loader bench <name>'
+SUBCOMMANDS = {
+    "control": "control_bench",
+    "tracking": "tracking",
+    "soak": "soak",
+    "compare": "compare",
+}
+
+
+def thread_counts(max_threads: int) -> List[int]:
+    """
+    Get the thread counts of the scaling curve.
+
+    Args:
+        max_threads: Largest thread count
+
+    Returns:
+        Powers of two below max_threads, followed by max_threads
+    """
+    counts = []
+    count = 1
+    while count < max_threads:
+        counts.append(count)
+        count *= 2
+    counts.append(max_threads)
+    return counts
+
+
+def measure(loader: CPULoader, duration: float, samples: int = 5) -> Dict[str, Any]:
+    """
+    Measure the throughput of all threads over a period.
+
+    The period is split into samples windows whose rates give the noise of
+    the measurement. Window rates are ops per busy second: the counters only
+    advance once per cycle, so dividing by wall time would add up to a cycle
+    of quantization error to every window.
+
+    Args:
+        loader: CPULoader with all threads running
+        duration: Seconds to measure
+        samples: Number of windows the period is split into
+
+    Returns:
+        Dictionary with aggregate and per-thread ops/s, the coefficient of
+        variation of the window rates, the mean CPU utilization of the
+        threads in percent and their effective clock while running (None
+        without a hardware cycle counter)
+    """
+    before = loader.get_all_stats()
+    start = time.monotonic()
+    window_rates = []
+    window_stats = before
+    for window in range(1, samples + 1):
+        time.sleep(max(start + duration * window / samples - time.monotonic(), 0.0))
+        stats = loader.get_all_stats()
+        ops = sum(s["ops"] - window_stats[t]["ops"] for t, s in stats.items())
+        busy = sum(s["busy_ns"] - window_stats[t]["busy_ns"] for t, s in stats.items())
+        if busy > 0:
+            window_rates.append(ops / busy)
+        window_stats = stats
+    after = window_stats
+    elapsed = time.monotonic() - start
+
+    per_thread = []
+    cpu_seconds = 0.0
+    user_seconds = 0.0
+    cpu_cycles = 0
+    counted = True
+    for thread_id, stats in after.items():
+        previous = before[thread_id]
+        per_thread.append((stats["ops"] - previous["ops"]) / elapsed)
+        cpu_seconds += (stats["cpu_time_ns"] - previous["cpu_time_ns"]) / 1e9
+        user_seconds += (stats["user_time_ns"] - previous["user_time_ns"]) / 1e9
+        cpu_cycles += stats["cpu_cycles"] - previous["cpu_cycles"]
+        counted = counted and stats["cycles_counted"]
+
+    cv = 0.0
+    if len(window_rates) > 1 and statistics.mean(window_rates) > 0:
+        cv = statistics.stdev(window_rates) / statistics.mean(window_rates)
+    return {
+        "duration_s": round(elapsed, 3),
+        "ops_per_sec": sum(per_thread),
+        "ops_per_sec_cv": round(cv, 5),
+        "ops_per_sec_per_thread": sum(per_thread) / len(per_thread),
+        "per_thread_ops_per_sec": per_thread,
+        "cpu_utilization_percent": round(
+            cpu_seconds / elapsed / len(per_thread) * 100.0, 1
+        ),
+        # The counters only count user-space cycles
+        "effective_mhz": (
+            round(cpu_cycles / user_seconds / 1e6, 1)
+            if counted and user_seconds > 0
+            else None
+        ),
+    }
+
+
+def add_frequency_ratios(results: List[Dict[str, Any]]):
+    """
+    Relate each point's effective clock to busy-wait at the same thread count.
+
+    Busy-wait barely exercises the execution units, so a ratio below 1 shows
+    how far a kernel downclocks (e.g. for wide vector instructions).
+
+    Args:
+        results: Benchmark results, updated in place with frequency_ratio
+    """
+    reference = {
+        r["threads"]: r["effective_mhz"]
+        for r in results
+        if r["kernel"] == "busy-wait" and r.get("effective_mhz")
+    }
+    for r in results:
+        base = reference.get(r["threads"])
+        if base and r.get("effective_mhz") is not None:
+            r["frequency_ratio"] = round(r["effective_mhz"] / base, 3)
+
+
+def run_benchmark(
+    kernels: Sequence[int],
+    counts: Sequence[int],
+    duration: float = 2.0,
+    warmup: float = 1.0,
+    progress=None,
+) -> List[Dict[str, Any]]:
+    """
+    Run every kernel at 100% load at every thread count.
+
+    Args:
+        kernels: Computation types to run
+        counts: Thread counts to run them at
+        duration: Seconds to measure each point
+        warmup: Warm-up time limit before each point (0 disables)
+        progress: Optional callable receiving each result as it is measured
+
+    Returns:
+        List of results, one per kernel and thread count, with the scaling
+        relative to one thread, the parallel efficiency and, when busy-wait
+        ran with a cycle counter, the clock relative to busy-wait
+    """
+    loader = CPULoader(counts[0])
+    results = []
+    try:
+        for num_threads in counts:
+            loader.set_num_threads(num_threads)
+            for kernel in kernels:
+                loader.set_computation_type(kernel)
+                if warmup > 0:
+                    loader.warmup(max_seconds=warmup)
+                loader.set_all_loads(100.0)
+
+                result = {
+                    "kernel": ComputationType.to_string(kernel),
+                    "op_unit": ComputationType.OP_UNITS[kernel],
+                    "threads": num_threads,
+                }
+                result.update(measure(loader, duration))
+                loader.set_all_loads(0.0)
+
+                # Scaling against the single-thread point of the same kernel
+                base = next(
+                    (
+                        r["ops_per_sec"]
+                        for r in results
+                        if r["kernel"] == result["kernel"] and r["threads"] == 1
+                    ),
+                    None,
+                )
+                if base:
+                    result["scaling"] = round(result["ops_per_sec"] / base, 3)
+                    result["efficiency"] = round(result["scaling"] / num_threads, 3)
+
+                results.append(result)
+                if progress is not None:
+                    progress(result)
+    finally:
+        loader.shutdown()
+
+    add_frequency_ratios(results)
+    return results
+
+
+def format_rate(value: Optional[float]) -> str:
+    """Format a rate with an SI suffix, e.g. 1.23G."""
+    if value is None:
+        return "-"
+    for suffix, scale in (("T", 1e12), ("G", 1e9), ("M", 1e6), ("k", 1e3)):
+        if abs(value) >= scale:
+            return f"{value / scale:.2f}{suffix}"
+    return f"{value:.1f}"
+
+
+def format_table(results: Sequence[Dict[str, Any]]) -> str:
+    """Format benchmark results as a fixed-width summary table."""
+    header = (
+        f"{'kernel':<10} {'threads':>7} {'ops/s':>10} {'ops/s/thread':>13} "
+        f"{'scaling':>8} {'efficiency':>10} {'cpu %':>6} {'MHz':>7} "
+        f"{'clock':>6}  unit"
+    )
+    lines = [header, "-" * len(header)]
+    for r in results:
+        scaling = r.get("scaling")
+        efficiency = r.get("efficiency")
+        mhz = r.get("effective_mhz")
+        ratio = r.get("frequency_ratio")
+        lines.append(
+            f"{r['kernel']:<10} {r['threads']:>7} "
+            f"{format_rate(r['ops_per_sec']):>10} "
+            f"{format_rate(r['ops_per_sec_per_thread']):>13} "
+            f"{scaling if scaling is not None else '-':>8} "
+            f"{efficiency if efficiency is not None else '-':>10} "
+            f"{r['cpu_utilization_percent']:>6} "
+            f"{round(mhz) if mhz is not None else '-':>7} "
+            f"{ratio if ratio is not None else '-':>6}  {r['op_unit']}"
+        )
+    return "\n".join(lines)
+
+
+def parse_args(argv: Optional[Sequence[str]] = None) -> argparse.Namespace:
+    """Parse benchmark command-line arguments."""
+    kernel_names = [
+        ComputationType.to_string(k) for k in sorted(ComputationType.OP_UNITS)
+    ]
+    parser = argparse.ArgumentParser(
+        prog="cpu-loader bench",
+        description="Run every kernel at 100% load at 1, 2, 4, ... N threads",
+        epilog=(
+            "'cpu-loader bench fit FILE' refits the scalability models, "
+            "'cpu-loader bench control' measures control-plane latency, "
+            "'cpu-loader bench tracking' load tracking quality and "
+            "'cpu-loader bench soak' long-term stability and "
+            "'cpu-loader bench compare BASE NEW' diffs two results."
+        ),
+    )
+    parser.add_argument(
+        "--threads",
+        type=int,
+        default=multiprocessing.cpu_count(),
+        help="Largest thread count (default: number of CPUs)",
+    )
+    parser.add_argument(
+        "--duration",
+        type=float,
+        default=2.0,
+        help="Seconds to measure each kernel and thread count (default: 2)",
+    )
+    parser.add_argument(
+        "--warmup",
+        type=float,
+        default=1.0,
+        help="Warm-up time limit before each measurement, 0 disables (default: 1)",
+    )
+    parser.add_argument(
+        "--kernels",
+        nargs="+",
+        choices=kernel_names,
+        default=kernel_names,
+        help="Kernels to run (default: all)",
+    )
+    parser.add_argument(
+        "--output",
+        default=DEFAULT_OUTPUT,
+        help=f"JSON result file, '-' for stdout (default: {DEFAULT_OUTPUT})",
+    )
+    args = parser.parse_args(argv)
+
+    if args.threads <= 0:
+        parser.error("--threads must be positive")
+    if args.duration <= 0:
+        parser.error("--duration must be positive")
+    if args.warmup < 0:
+        parser.error("--warmup must not be negative")
+
+    return args
+
+
+def fit_main(argv: Sequence[str]) -> int:
+    """Entry point of 'cpu-loader bench fit', refits saved results."""
+    parser = argparse.ArgumentParser(
+        prog="cpu-loader bench fit",
+        description="Fit Amdahl and USL parameters to saved benchmark results",
+    )
+    parser.add_argument("file", help="JSON result file of 'cpu-loader bench'")
+    parser.add_argument(
+        "--json", action="store_true", help="Print the fits as JSON instead"
+    )
+    args = parser.parse_args(argv)
+
+    with open(args.file) as f:
+        fits = fit_results(json.load(f)["results"])
+
+    if args.json:
+        print(json.dumps(fits, indent=2))
+    else:
+        print(format_fit_table(fits))
+    return 0
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    """Entry point of 'cpu-loader bench'."""
+    if argv is None:
+        argv = sys.argv[1:]
+    if argv and argv[0] == "fit":
+        return fit_main(argv[1:])
+    if argv and argv[0] in SUBCOMMANDS:
+        # Imported on demand, the control benchmark needs the server modules
+        module = importlib.import_module(f"cpu_loader.{SUBCOMMANDS[argv[0]]}")
+        return module.main(argv[1:])
+
+    args = parse_args(argv)
+    kernels = [ComputationType.from_string(k) for k in args.kernels]
+    counts = thread_counts(args.threads)
+
+    # Progress goes to stderr so that '--output -' keeps stdout valid JSON
+    def progress(result):
+        print(
+            f"{result['kernel']:<10} {result['threads']:>4} threads: "
+            f"{format_rate(result['ops_per_sec'])} {result['op_unit']}/s",
+            file=sys.stderr,
+        )
+
+    started = datetime.now(timezone.utc)
+    results = run_benchmark(kernels, counts, args.duration, args.warmup, progress)
+
+    report = {
+        "schema_version": SCHEMA_VERSION,
+        "started": started.isoformat(),
+        "host": read_host_metadata(),
+        "config": {
+            "threads": counts,
+            "duration_s": args.duration,
+            "warmup_s": args.warmup,
+            "kernels": args.kernels,
+        },
+        "results": results,
+        "scalability": fit_results(results),
+    }
+
+    if args.output == "-":
+        json.dump(report, sys.stdout, indent=2)
+        print()
+    else:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    # The table goes to stdout unless stdout carries the JSON
+    table_stream = sys.stderr if args.output == "-" else sys.stdout
+    print(file=table_stream)
+    print(format_table(results), file=table_stream)
+    print(file=table_stream)
+    print(format_fit_table(report["scalability"]), file=table_stream)
+    if args.output != "-":
+        print(f"\nResults written to {args.output}", file=table_stream)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,142 @@
+"""
+Calibration Cache Module
+Persists the stable kernel throughput found by warm-ups, so that a restarted
+loader only has to confirm it instead of waiting for it to settle again.
+"""
+
+import hashlib
+import json
+import logging
+import os
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Dict, Optional
+
+from cpu_loader import cpu_loader_core  # type: ignore[attr-defined]
+from cpu_loader.sensors import read_host_metadata
+
+logger = logging.getLogger(__name__)
+
+CACHE_VERSION = 1
+DEFAULT_CACHE_PATH = (
+    Path(os.environ.get("XDG_CACHE_HOME") or Path.home() / ".cache")
+    / "cpu-loader"
+    / "calibration.json"
+)
+
+
+def build_id() -> str:
+    """
+    Identify the build of the native engine.
+
+    Returns:
+        Hash of the loaded extension module, or 'unknown' if unreadable
+    """
+    try:
+        binary = Path(cpu_loader_core.__file__).read_bytes()
+    except (AttributeError, OSError):
+        return "unknown"
+    return hashlib.sha256(binary).hexdigest()[:16]
+
+
+def calibration_key() -> Dict[str, Any]:
+    """
+    Get what calibration results depend on.
+
+    Returns:
+        Dictionary with the CPU model, microcode revision, kernel release and
+        engine build
+    """
+    host = read_host_metadata()
+    return {
+        "cpu_model": host["cpu_model"],
+        "microcode": host["microcode"],
+        "kernel": host["kernel"],
+        "build": build_id(),
+    }
+
+
+class CalibrationCache:
+    """
+    Stable aggregate ops/s per kernel and thread count, stored as JSON.
+
+    The file holds one entry per calibration key, so a home directory shared
+    between hosts keeps the results of each of them. Results of a different
+    CPU, microcode, kernel or engine build are never used.
+    """
+
+    def __init__(self, path: Optional[os.PathLike] = None):
+        """
+        Initialize the cache and load the entry of this host.
+
+        Args:
+            path: Cache file (default: ~/.cache/cpu-loader/calibration.json)
+        """
+        self.path = Path(path) if path is not None else DEFAULT_CACHE_PATH
+        self.key = calibration_key()
+        self.key_id = hashlib.sha256(
+            json.dumps(self.key, sort_keys=True).encode()
+        ).hexdigest()[:16]
+        self._entries = self._load()
+
+    def _load(self) -> Dict[str, Any]:
+        """Read all entries, an unreadable or outdated file counts as empty."""
+        try:
+            with open(self.path) as f:
+                data = json.load(f)
+        except FileNotFoundError:
+            return {}
+        except (OSError, ValueError) as e:
+            logger.warning(f"Ignoring calibration cache {self.path}: {e}")
+            return {}
+
+        if not isinstance(data, dict) or data.get("version") != CACHE_VERSION:
+            return {}
+        return data.get("entries", {})
+
+    def lookup(self, kernel: str, threads: int) -> Optional[float]:
+        """
+        Get the cached throughput of a kernel.
+
+        Args:
+            kernel: Computation type name
+            threads: Number of worker threads
+
+        Returns:
+            Aggregate ops/s, or None if not cached for this host
+        """
+        kernels = self._entries.get(self.key_id, {}).get("kernels", {})
+        result = kernels.get(kernel, {}).get(str(threads))
+        return result["ops_per_sec"] if result else None
+
+    def store(self, kernel: str, threads: int, ops_per_sec: float):
+        """
+        Remember the throughput of a kernel until save() writes it.
+
+        Args:
+            kernel: Computation type name
+            threads: Number of worker threads
+            ops_per_sec: Stable aggregate ops/s
+        """
+        entry = self._entries.setdefault(self.key_id, {"key": self.key, "kernels": {}})
+        entry["kernels"].setdefault(kernel, {})[str(threads)] = {
+            "ops_per_sec": ops_per_sec,
+            "updated": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+        }
+
+    def save(self):
+        """Write the cache file atomically. Failures are logged, not raised."""
+        data = {"version": CACHE_VERSION, "entries": self._entries}
+        tmp_path = self.path.with_name(f"{self.path.name}.{os.getpid()}.tmp")
+        try:
+            self.path.parent.mkdir(parents=True, exist_ok=True)
+            with open(tmp_path, "w") as f:
+                json.dump(data, f, indent=2)
+            os.replace(tmp_path, self.path)
+        except (OSError, TypeError, ValueError) as e:
+            logger.warning(f"Failed to write calibration cache {self.path}: {e}")
+            # Do not leave a partial file behind
+            try:
+                tmp_path.unlink()
+            except OSError:
+                pass
@@ -0,0 +1,234 @@
+"""
+Benchmark Comparison Module
+Diffs two 'cpu-loader bench' result files per kernel and thread count, and
+flags changes larger than the noise of the two measurements as regressions
+or improvements.
+"""
+
+import argparse
+import json
+import math
+import sys
+from typing import Any, Dict, List, Optional, Sequence, Tuple
+
+from cpu_loader.bench import SCHEMA_VERSION, format_rate
+
+# Host metadata fields shown when they differ between the two runs
+HOST_FIELDS = (
+    "cpu_model",
+    "microcode",
+    "kernel",
+    "governor",
+    "smt",
+    "smt_active",
+    "cpus",
+    "machine",
+)
+
+
+def load_report(path: str) -> Dict[str, Any]:
+    """
+    Load a benchmark result file.
+
+    Args:
+        path: JSON result file of 'cpu-loader bench'
+
+    Returns:
+        The report dictionary
+
+    Raises:
+        ValueError: If the file has no results or a newer schema version
+    """
+    with open(path) as f:
+        report = json.load(f)
+
+    version = report.get("schema_version", 1)
+    if version > SCHEMA_VERSION:
+        raise ValueError(
+            f"{path}: schema version {version} is newer than {SCHEMA_VERSION}"
+        )
+    if "results" not in report:
+        raise ValueError(f"{path}: not a benchmark result file")
+    return report
+
+
+def host_differences(
+    base: Dict[str, Any], new: Dict[str, Any]
+) -> Dict[str, Tuple[Any, Any]]:
+    """
+    Get the host metadata fields that differ between two reports.
+
+    Args:
+        base: Baseline report
+        new: Report compared against it
+
+    Returns:
+        Dictionary mapping field name to its (base, new) values. Fields
+        missing from a version 1 report are not compared.
+    """
+    base_host = base.get("host", {})
+    new_host = new.get("host", {})
+    return {
+        field: (base_host[field], new_host[field])
+        for field in HOST_FIELDS
+        if field in base_host
+        and field in new_host
+        and base_host[field] != new_host[field]
+    }
+
+
+def compare_results(
+    base: Sequence[Dict[str, Any]],
+    new: Sequence[Dict[str, Any]],
+    min_change: float = 2.0,
+    sigma: float = 3.0,
+) -> List[Dict[str, Any]]:
+    """
+    Compare two sets of benchmark results point by point.
+
+    A change counts when it exceeds both min_change and sigma times the
+    combined noise of the two points, estimated from their ops_per_sec_cv.
+    Results without a cv (schema version 1) contribute no noise.
+
+    Args:
+        base: Baseline results
+        new: Results compared against them
+        min_change: Smallest change in percent that counts
+        sigma: Noise multiple a change must exceed
+
+    Returns:
+        List of comparisons, one per kernel and thread count of either run,
+        with the change and threshold in percent and a status of
+        'regression', 'improvement', 'same', 'missing' (only in base) or
+        'new' (only in new)
+    """
+    base_points = {(r["kernel"], r["threads"]): r for r in base}
+    new_points = {(r["kernel"], r["threads"]): r for r in new}
+
+    comparisons = []
+    for key in list(base_points) + [k for k in new_points if k not in base_points]:
+        base_point = base_points.get(key)
+        new_point = new_points.get(key)
+        comparison: Dict[str, Any] = {
+            "kernel": key[0],
+            "threads": key[1],
+            "base_ops_per_sec": base_point and base_point["ops_per_sec"],
+            "new_ops_per_sec": new_point and new_point["ops_per_sec"],
+        }
+
+        if base_point is None or new_point is None:
+            comparison["status"] = "new" if base_point is None else "missing"
+        elif base_point["ops_per_sec"] <= 0:
+            comparison["status"] = "same"
+        else:
+            change = new_point["ops_per_sec"] / base_point["ops_per_sec"] - 1.0
+            noise = math.hypot(
+                base_point.get("ops_per_sec_cv", 0.0),
+                new_point.get("ops_per_sec_cv", 0.0),
+            )
+            threshold = max(min_change, sigma * noise * 100.0)
+            comparison["change_percent"] = round(change * 100.0, 2)
+            comparison["threshold_percent"] = round(threshold, 2)
+            if change * 100.0 < -threshold:
+                comparison["status"] = "regression"
+            elif change * 100.0 > threshold:
+                comparison["status"] = "improvement"
+            else:
+                comparison["status"] = "same"
+
+        comparisons.append(comparison)
+
+    return comparisons
+
+
+def format_compare_table(comparisons: Sequence[Dict[str, Any]]) -> str:
+    """Format comparisons as one line per kernel and thread count."""
+    header = (
+        f"{'kernel':<10} {'threads':>7} {'base':>10} {'new':>10} "
+        f"{'change':>8} {'noise':>7}  status"
+    )
+    lines = [header, "-" * len(header)]
+    for c in comparisons:
+        change = c.get("change_percent")
+        threshold = c.get("threshold_percent")
+        lines.append(
+            f"{c['kernel']:<10} {c['threads']:>7} "
+            f"{format_rate(c['base_ops_per_sec']):>10} "
+            f"{format_rate(c['new_ops_per_sec']):>10} "
+            f"{f'{change:+.1f}%' if change is not None else '-':>8} "
+            f"{f'±{threshold:.1f}%' if threshold is not None else '-':>7}  "
+            f"{c['status']}"
+        )
+    return "\n".join(lines)
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    """Entry point of 'cpu-loader bench compare'."""
+    parser = argparse.ArgumentParser(
+        prog="cpu-loader bench compare",
+        description=(
+            "Compare two benchmark result files per kernel and thread count, "
+            "exits with 1 if any point regressed"
+        ),
+    )
+    parser.add_argument("base", help="Baseline JSON result file")
+    parser.add_argument("new", help="JSON result file to compare against it")
+    parser.add_argument(
+        "--min-change",
+        type=float,
+        default=2.0,
+        help="Smallest change in percent that counts (default: 2)",
+    )
+    parser.add_argument(
+        "--sigma",
+        type=float,
+        default=3.0,
+        help="Noise multiple a change must exceed (default: 3)",
+    )
+    parser.add_argument(
+        "--json", action="store_true", help="Print the comparison as JSON instead"
+    )
+    args = parser.parse_args(argv)
+
+    if args.min_change < 0:
+        parser.error("--min-change must not be negative")
+    if args.sigma < 0:
+        parser.error("--sigma must not be negative")
+
+    try:
+        base = load_report(args.base)
+        new = load_report(args.new)
+    except (OSError, ValueError) as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 2
+
+    comparisons = compare_results(
+        base["results"], new["results"], args.min_change, args.sigma
+    )
+    differences = host_differences(base, new)
+    regressed = any(c["status"] == "regression" for c in comparisons)
+
+    if args.json:
+        report = {
+            "base": args.base,
+            "new": args.new,
+            "host_differences": {
+                field: {"base": b, "new": n} for field, (b, n) in differences.items()
+            },
+            "comparisons": comparisons,
+            "regressed": regressed,
+        }
+        print(json.dumps(report, indent=2))
+    else:
+        if differences:
+            print("Host differences, results may not be comparable:")
+            for field, (b, n) in differences.items():
+                print(f"  {field}: {b} -> {n}")
+            print()
+        print(format_compare_table(comparisons))
+
+    return 1 if regressed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,356 @@
+"""
+Control-Plane Latency Benchmark Module
+Measures how long a load change takes from being issued through each control
+interface (Python API, REST, WebSocket, MQTT) until the worker thread runs
+with it.
+"""
+
+import argparse
+import json
+import os
+import random
+import socket
+import sys
+import threading
+import time
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple
+
+from cpu_loader.victim import LatencyHistogram
+
+PATHS = ("python", "rest", "websocket", "mqtt")
+POLL_INTERVAL = 0.0001
+APPLY_TIMEOUT = 5.0
+DEFAULT_OUTPUT = "cpu-loader-control-bench.json"
+
+
+def wait_applied(loader, thread_id: int, before_seq: int) -> Tuple[int, int]:
+    """
+    Wait until a load change issued after before_seq is in effect.
+
+    Args:
+        loader: CPULoader the change was sent to
+        thread_id: Thread whose load was changed
+        before_seq: The thread's load_seq before the change was issued
+
+    Returns:
+        Tuple of CLOCK_MONOTONIC nanoseconds when the setting was seen stored
+        (polled, so late by up to the poll interval) and when the worker
+        picked it up (exact, recorded by the worker)
+    """
+    deadline = time.monotonic() + APPLY_TIMEOUT
+    stored_ns = None
+    target_seq = None
+
+    while time.monotonic() < deadline:
+        stats = loader.get_thread_stats(thread_id)
+        if stored_ns is None and stats["load_seq"] > before_seq:
+            stored_ns = time.monotonic_ns()
+            target_seq = stats["load_seq"]
+        if target_seq is not None and stats["applied_seq"] >= target_seq:
+            return stored_ns, stats["applied_ns"]
+        time.sleep(POLL_INTERVAL)
+
+    raise TimeoutError(f"Load change not applied within {APPLY_TIMEOUT} s")
+
+
+def measure_path(
+    loader,
+    issue: Callable[[int, float], None],
+    samples: int,
+    thread_id: int = 0,
+    drain: Optional[Callable[[], None]] = None,
+) -> Dict[str, Any]:
+    """
+    Issue load changes through one path and record their latencies.
+
+    Loads alternate between 30% and 70%, separated by random pauses so the
+    changes land at random points of the worker's cycle.
+
+    Args:
+        loader: CPULoader whose worker statistics are observed
+        issue: Callable sending a (thread_id, load_percent) change
+        samples: Number of load changes
+        thread_id: Thread to change
+        drain: Optional callable run after each change (e.g. read the reply)
+
+    Returns:
+        Dictionary with 'stored' (issued until the setting is stored) and
+        'applied' (issued until the worker runs with it) latency summaries
+    """
+    stored = LatencyHistogram()
+    applied = LatencyHistogram()
+
+    for sample in range(samples):
+        load = 30.0 if sample % 2 == 0 else 70.0
+        before_seq = loader.get_thread_stats(thread_id)["load_seq"]
+
+        start_ns = time.monotonic_ns()
+        issue(thread_id, load)
+        stored_ns, applied_ns = wait_applied(loader, thread_id, before_seq)
+
+        stored.record(stored_ns - start_ns)
+        applied.record(applied_ns - start_ns)
+        if drain is not None:
+            drain()
+
+        time.sleep(random.uniform(0.02, 0.05))
+
+    return {"stored": stored.summary(), "applied": applied.summary()}
+
+
+class InProcessServer:
+    """
+    Runs the REST/WebSocket server on a loopback port in a background
+    thread, so the benchmark can observe the server's loader directly.
+    """
+
+    def __init__(self, mqtt_args: Dict[str, Any]):
+        import uvicorn
+
+        from cpu_loader import main as server
+
+        self.server_module = server
+        server.app.state.mqtt_args = mqtt_args
+
+        with socket.socket() as sock:
+            sock.bind(("127.0.0.1", 0))
+            self.port = sock.getsockname()[1]
+
+        config = uvicorn.Config(
+            server.app, host="127.0.0.1", port=self.port, log_level="warning"
+        )
+        self._server = uvicorn.Server(config)
+        self._thread = threading.Thread(
+            target=self._server.run, name="control-bench-server", daemon=True
+        )
+
+    @property
+    def url(self) -> str:
+        return f"http://127.0.0.1:{self.port}"
+
+    @property
+    def loader(self):
+        return self.server_module.cpu_loader
+
+    @property
+    def mqtt_publisher(self):
+        return self.server_module.mqtt_publisher
+
+    def __enter__(self):
+        self._thread.start()
+        deadline = time.monotonic() + 10.0
+        while not self._server.started:
+            if time.monotonic() > deadline or not self._thread.is_alive():
+                raise RuntimeError("Server did not start")
+            time.sleep(0.01)
+        return self
+
+    def __exit__(self, *exc):
+        self._server.should_exit = True
+        self._thread.join()
+
+
+def run_control_benchmark(
+    paths: Sequence[str], samples: int, mqtt_args: Dict[str, Any], progress=None
+) -> Dict[str, Dict[str, Any]]:
+    """
+    Measure the control latency of each path against an in-process server.
+
+    Args:
+        paths: Paths to measure (python, rest, websocket, mqtt)
+        samples: Load changes per path
+        mqtt_args: MQTTPublisher arguments, the mqtt path needs a broker
+        progress: Optional callable receiving (path, result) when measured
+
+    Returns:
+        Dictionary mapping path to its latency summaries, or to an 'error'
+        entry if the path could not be measured
+    """
+    results: Dict[str, Dict[str, Any]] = {}
+
+    with InProcessServer(mqtt_args) as server:
+        loader = server.loader
+        for path in paths:
+            try:
+                results[path] = _measure(path, server, loader, samples)
+            except Exception as e:
+                results[path] = {"error": str(e)}
+            if progress is not None:
+                progress(path, results[path])
+
+    return results
+
+
+def _measure(path: str, server: InProcessServer, loader, samples: int) -> Dict:
+    """Set up the client of one path and measure it."""
+    if path == "python":
+        return measure_path(loader, loader.set_thread_load, samples)
+
+    if path == "rest":
+        import requests
+
+        with requests.Session() as session:
+
+            def issue_rest(thread_id: int, load: float):
+                response = session.put(
+                    f"{server.url}/api/threads/{thread_id}/load",
+                    json={"load_percent": load},
+                )
+                response.raise_for_status()
+
+            return measure_path(loader, issue_rest, samples)
+
+    if path == "websocket":
+        from websockets.sync.client import connect
+
+        ws_url = f"ws://127.0.0.1:{server.port}/ws/cpu-metrics"
+        with connect(ws_url) as ws:
+            sent: List[int] = []
+
+            def issue_ws(thread_id: int, load: float):
+                sent.append(len(sent))
+                ws.send(
+                    json.dumps(
+                        {
+                            "type": "set_load",
+                            "id": sent[-1],
+                            "thread_id": thread_id,
+                            "load_percent": load,
+                        }
+                    )
+                )
+
+            def drain_ws():
+                # Skip metrics broadcasts until the acknowledgement arrives
+                while True:
+                    reply = json.loads(ws.recv(timeout=APPLY_TIMEOUT))
+                    if reply.get("id") == sent[-1]:
+                        return
+
+            return measure_path(loader, issue_ws, samples, drain=drain_ws)
+
+    if path == "mqtt":
+        publisher = server.mqtt_publisher
+        if publisher is None or publisher.client is None:
+            raise RuntimeError("No MQTT broker configured")
+
+        deadline = time.monotonic() + 5.0
+        while not publisher.connected:
+            if time.monotonic() > deadline:
+                raise RuntimeError("Server did not connect to the MQTT broker")
+            time.sleep(0.05)
+
+        import paho.mqtt.client as mqtt
+
+        client = mqtt.Client(
+            client_id=f"cpu-loader-bench-{os.getpid()}", protocol=mqtt.MQTTv311
+        )
+        if publisher.username:
+            client.username_pw_set(publisher.username, publisher.password)
+        client.connect(publisher.broker_host, publisher.broker_port)
+        client.loop_start()
+        topic = f"{publisher.topic_prefix}/set/load"
+        try:
+
+            def issue_mqtt(thread_id: int, load: float):
+                payload = {"thread_id": thread_id, "load_percent": load}
+                client.publish(topic, json.dumps(payload), qos=1)
+
+            # The server subscribes asynchronously after connecting
+            time.sleep(0.5)
+            return measure_path(loader, issue_mqtt, samples)
+        finally:
+            client.loop_stop()
+            client.disconnect()
+
+    raise ValueError(f"Invalid path '{path}'. Available: {', '.join(PATHS)}")
+
+
+def format_control_table(results: Dict[str, Dict[str, Any]]) -> str:
+    """Format control latencies as one line per path and stage."""
+    columns = ("p50_us", "p90_us", "p99_us", "max_us")
+    header = f"{'path':<10} {'stage':<8}" + "".join(
+        f" {c[:-3] + ' us':>10}" for c in columns
+    )
+    lines = [header, "-" * len(header)]
+    for path, result in results.items():
+        if "error" in result:
+            lines.append(f"{path:<10} {'-':<8} {result['error']}")
+            continue
+        for stage in ("stored", "applied"):
+            summary = result[stage]
+            lines.append(
+                f"{path:<10} {stage:<8}"
+                + "".join(f" {str(summary[c]):>10}" for c in columns)
+            )
+    return "\n".join(lines)
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    """Entry point of 'cpu-loader bench control'."""
+    parser = argparse.ArgumentParser(
+        prog="cpu-loader bench control",
+        description=(
+            "Measure the latency of load changes through each control path, "
+            "from issuing until the worker runs with the new load"
+        ),
+    )
+    parser.add_argument(
+        "--paths",
+        nargs="+",
+        choices=PATHS,
+        default=list(PATHS),
+        help="Control paths to measure (default: all)",
+    )
+    parser.add_argument(
+        "--samples", type=int, default=100, help="Load changes per path (default: 100)"
+    )
+    parser.add_argument(
+        "--mqtt-broker-host",
+        help="MQTT broker for the mqtt path (env: MQTT_BROKER_HOST)",
+    )
+    parser.add_argument("--mqtt-broker-port", type=int, help="MQTT broker port")
+    parser.add_argument(
+        "--output",
+        default=DEFAULT_OUTPUT,
+        help=f"JSON result file, '-' for stdout (default: {DEFAULT_OUTPUT})",
+    )
+    args = parser.parse_args(argv)
+
+    if args.samples <= 0:
+        parser.error("--samples must be positive")
+
+    mqtt_args: Dict[str, Any] = {}
+    if args.mqtt_broker_host:
+        mqtt_args["broker_host"] = args.mqtt_broker_host
+    if args.mqtt_broker_port:
+        mqtt_args["broker_port"] = args.mqtt_broker_port
+    # Keep the benchmark's MQTT client ID distinct from a running loader
+    mqtt_args["client_id"] = f"cpu-loader-control-bench-{os.getpid()}"
+
+    def progress(path, result):
+        status = result.get("error") or f"p50 {result['applied']['p50_us']} us"
+        print(f"{path:<10} {status}", file=sys.stderr)
+
+    results = run_control_benchmark(args.paths, args.samples, mqtt_args, progress)
+    report = {"samples": args.samples, "paths": results}
+
+    if args.output == "-":
+        json.dump(report, sys.stdout, indent=2)
+        print()
+    else:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    # The table goes to stdout unless stdout carries the JSON
+    table_stream = sys.stderr if args.output == "-" else sys.stdout
+    print(file=table_stream)
+    print(format_control_table(results), file=table_stream)
+    if args.output != "-":
+        print(f"\nResults written to {args.output}", file=table_stream)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
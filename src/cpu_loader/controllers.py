@@ -0,0 +1,890 @@
+"""
+Load Controllers Module
+Closed-loop controllers that drive the CPU loader's core budget from
+process, cgroup and host sensors.
+"""
+
+import logging
+import os
+import threading
+import time
+from pathlib import Path
+from typing import Any, Dict, Optional, Sequence, Tuple
+
+from cpu_loader import sensors
+from cpu_loader.cpu_loader import ComputationType
+from cpu_loader.overhead import OverheadMeter
+
+logger = logging.getLogger(__name__)
+
+
+class LoadController:
+    """
+    Base class for controllers that periodically recompute the loader's
+    core budget in a background thread.
+
+    Subclasses implement step(), which returns the new budget in cores.
+    Controllers that change the computation type do so with set_kernel(),
+    so that stop() hands the loader back with the user's kernel.
+    """
+
+    mode = "none"
+
+    def __init__(self, loader, interval: float = 1.0, distribution: str = "spread"):
+        """
+        Initialize the controller.
+
+        Args:
+            loader: CPULoader instance to drive
+            interval: Seconds between control steps
+            distribution: How the budget is distributed ('pack' or 'spread')
+        """
+        if interval <= 0:
+            raise ValueError("Interval must be positive")
+
+        if distribution not in loader.BUDGET_DISTRIBUTIONS:
+            available = ", ".join(loader.BUDGET_DISTRIBUTIONS)
+            raise ValueError(
+                f"Invalid distribution '{distribution}'. Available: {available}"
+            )
+
+        self.loader = loader
+        self.interval = interval
+        self.distribution = distribution
+        self.budget = 0.0
+        self.error: Optional[str] = None
+        self._stop_event = threading.Event()
+        self._thread: Optional[threading.Thread] = None
+        self._saved_kernels: Optional[Tuple[int, Dict[int, int]]] = None
+
+    def start(self):
+        """Start the control loop in a background thread."""
+        self._stop_event.clear()
+        self._thread = threading.Thread(
+            target=self._run, name=f"controller-{self.mode}", daemon=True
+        )
+        self._thread.start()
+
+    def stop(self):
+        """Stop the control loop and wait for it to finish."""
+        self._stop_event.set()
+        if self._thread and self._thread is not threading.current_thread():
+            self._thread.join()
+        self._thread = None
+
+        if self._saved_kernels is not None:
+            self.loader.restore_kernels(self._saved_kernels)
+            self._saved_kernels = None
+
+    def set_kernel(self, kernel: int):
+        """Switch the computation type, the previous ones are restored by stop()."""
+        if self._saved_kernels is None:
+            self._saved_kernels = self.loader.save_kernels()
+        self.loader.set_computation_type(kernel)
+
+    def is_running(self) -> bool:
+        """Return True while the control loop is active."""
+        return self._thread is not None and self._thread.is_alive()
+
+    def step(self) -> float:
+        """Compute the new core budget. Implemented by subclasses."""
+        raise NotImplementedError
+
+    def status(self) -> Dict[str, Any]:
+        """Get the controller state for reporting."""
+        return {
+            "mode": self.mode,
+            "running": self.is_running(),
+            "interval": self.interval,
+            "distribution": self.distribution,
+            "budget_cores": round(self.budget, 3),
+            "error": self.error,
+        }
+
+    def apply_budget(self, cores: float):
+        """Clamp a core budget to the available threads and apply it."""
+        self.budget = min(max(cores, 0.0), float(self.loader.num_threads))
+        self.loader.set_core_budget(self.budget, self.distribution)
+
+    def _run(self):
+        """Control loop, runs until stopped or the sensor fails."""
+        while not self._stop_event.wait(self.interval):
+            try:
+                self.apply_budget(self.step())
+            except (OSError, ValueError) as e:
+                # The sensor went away (process exited, cgroup removed, ...)
+                logger.error(f"{self.mode} controller stopped: {e}")
+                self.error = str(e)
+                self.apply_budget(0.0)
+                return
+            except Exception as e:
+                logger.error(f"Error in {self.mode} controller: {e}")
+
+
+class ShadowController(LoadController):
+    """
+    Mirrors the CPU usage of another process or cgroup.
+
+    Modes:
+        replicate: generate the same number of cores as the target uses
+        scale: generate factor times the target's usage
+        invert: fill the capacity the target leaves unused
+
+    With subtract_overhead the CPU usage of the loader's own control plane is
+    taken off the budget, so the whole process rather than only its workers
+    follows the target.
+    """
+
+    mode = "shadow"
+    SHADOW_MODES = ("replicate", "scale", "invert")
+
+    def __init__(
+        self,
+        loader,
+        pid: Optional[int] = None,
+        cgroup: Optional[str] = None,
+        shadow_mode: str = "replicate",
+        factor: float = 1.0,
+        capacity: Optional[float] = None,
+        smoothing: float = 0.3,
+        interval: float = 0.1,
+        distribution: str = "spread",
+        subtract_overhead: bool = False,
+    ):
+        """
+        Initialize the shadow controller.
+
+        Args:
+            loader: CPULoader instance to drive
+            pid: Process to mirror (all of its threads)
+            cgroup: cgroup to mirror, as name or path below /sys/fs/cgroup
+            shadow_mode: 'replicate', 'scale' or 'invert'
+            factor: Multiplier for 'scale' mode
+            capacity: Cores the target could use, for 'invert' mode. Defaults
+                      to the cgroup's cpu.max limit or the number of threads.
+            smoothing: EWMA weight of the newest sample (0 < smoothing <= 1)
+            interval: Seconds between samples
+            distribution: How the budget is distributed ('pack' or 'spread')
+            subtract_overhead: Take the control plane's CPU usage off the
+                               budget
+
+        Raises:
+            OSError: If subtract_overhead is set on a host without per-thread
+                     scheduler statistics
+        """
+        super().__init__(loader, interval, distribution)
+
+        if (pid is None) == (cgroup is None):
+            raise ValueError("Exactly one of pid or cgroup must be given")
+
+        if pid is not None and pid == os.getpid():
+            raise ValueError("Cannot shadow the loader's own process")
+
+        if shadow_mode not in self.SHADOW_MODES:
+            available = ", ".join(self.SHADOW_MODES)
+            raise ValueError(
+                f"Invalid shadow mode '{shadow_mode}'. Available: {available}"
+            )
+
+        if factor < 0:
+            raise ValueError("Factor must not be negative")
+
+        if smoothing <= 0 or smoothing > 1:
+            raise ValueError("Smoothing must be between 0 (exclusive) and 1")
+
+        self.pid = pid
+        self.cgroup = cgroup
+        self.shadow_mode = shadow_mode
+        self.factor = factor if shadow_mode == "scale" else 1.0
+        self.smoothing = smoothing
+
+        if capacity is None and cgroup is not None:
+            capacity = sensors.read_cgroup_cpu_limit(cgroup)
+        self.capacity = capacity if capacity is not None else float(loader.num_threads)
+
+        self.usage = 0.0
+        self.overhead = 0.0
+        self.overhead_meter = OverheadMeter(loader) if subtract_overhead else None
+        self._last_cpu = self._read_cpu_seconds()
+        self._last_time = time.monotonic()
+
+    def _read_cpu_seconds(self) -> float:
+        """Read the target's cumulative CPU seconds."""
+        if self.pid is not None:
+            return sensors.read_process_cpu_seconds(self.pid)
+        return sensors.read_cgroup_cpu_seconds(self.cgroup)
+
+    def step(self) -> float:
+        """Sample the target's usage and derive the budget from it."""
+        cpu = self._read_cpu_seconds()
+        now = time.monotonic()
+
+        elapsed = now - self._last_time
+        if elapsed > 0:
+            sample = max(cpu - self._last_cpu, 0.0) / elapsed
+            self.usage += self.smoothing * (sample - self.usage)
+        self._last_cpu = cpu
+        self._last_time = now
+
+        if self.overhead_meter is not None:
+            sample = self.overhead_meter.sample()["overhead_cores"]
+            self.overhead += self.smoothing * (sample - self.overhead)
+
+        if self.shadow_mode == "invert":
+            return self.capacity - self.usage - self.overhead
+        return self.usage * self.factor - self.overhead
+
+    def status(self) -> Dict[str, Any]:
+        """Get the controller state for reporting."""
+        status = super().status()
+        status.update(
+            {
+                "pid": self.pid,
+                "cgroup": self.cgroup,
+                "shadow_mode": self.shadow_mode,
+                "factor": self.factor,
+                "capacity": self.capacity,
+                "target_usage_cores": round(self.usage, 3),
+                "subtract_overhead": self.overhead_meter is not None,
+                "overhead_cores": round(self.overhead, 3),
+            }
+        )
+        return status
+
+
+class HostTargetController(LoadController):
+    """
+    Holds total host CPU utilization at a target by filling the headroom
+    left by other workloads.
+
+    Host utilization comes from /proc/stat; the loader's own contribution
+    (CPU time of its worker threads) is subtracted to get the load of
+    everything else, and the budget is set to the remaining headroom. The
+    control plane's own CPU usage is reported apart from the other workloads
+    but, like them, comes out of the headroom.
+    """
+
+    mode = "host-target"
+
+    def __init__(
+        self,
+        loader,
+        target_percent: float,
+        gain: float = 0.5,
+        interval: float = 1.0,
+        distribution: str = "spread",
+    ):
+        """
+        Initialize the host target controller.
+
+        Args:
+            loader: CPULoader instance to drive
+            target_percent: Target total host CPU utilization (0-100)
+            gain: Fraction of the error corrected per step (0 < gain <= 1)
+            interval: Seconds between control steps
+            distribution: How the budget is distributed ('pack' or 'spread')
+        """
+        super().__init__(loader, interval, distribution)
+
+        if target_percent < 0 or target_percent > 100:
+            raise ValueError("Target percent must be between 0 and 100")
+
+        if gain <= 0 or gain > 1:
+            raise ValueError("Gain must be between 0 (exclusive) and 1")
+
+        self.target_percent = target_percent
+        self.gain = gain
+        self.host_percent = 0.0
+        self.other_cores = 0.0
+        self.overhead_cores = 0.0
+        # Without per-thread statistics the overhead counts as other workloads
+        try:
+            self.overhead_meter: Optional[OverheadMeter] = OverheadMeter(loader)
+        except OSError:
+            self.overhead_meter = None
+
+        self._last_host = sensors.read_host_cpu_times()
+        self._last_own = self._read_own_cpu_seconds()
+        self._last_time = time.monotonic()
+
+    def _read_own_cpu_seconds(self) -> float:
+        """CPU seconds consumed by the loader's worker threads."""
+        stats = self.loader.get_all_stats()
+        return sum(s["cpu_time_ns"] for s in stats.values()) / 1e9
+
+    def step(self) -> float:
+        """Measure the other workloads and move the budget to the headroom."""
+        host = sensors.read_host_cpu_times()
+        own = self._read_own_cpu_seconds()
+        now = time.monotonic()
+
+        busy, total, num_cpus = host
+        elapsed = now - self._last_time
+        delta_total = total - self._last_host[1]
+        if elapsed <= 0 or delta_total <= 0:
+            return self.budget
+
+        host_cores = (busy - self._last_host[0]) / delta_total * num_cpus
+        # Worker threads are recreated when the thread count changes, which
+        # resets their CPU time counters
+        own_cores = max(own - self._last_own, 0.0) / elapsed
+        self._last_host = host
+        self._last_own = own
+        self._last_time = now
+
+        self.host_percent = host_cores / num_cpus * 100.0
+        if self.overhead_meter is not None:
+            self.overhead_cores = self.overhead_meter.sample()["overhead_cores"]
+        other_cores = max(host_cores - own_cores, 0.0)
+        self.other_cores = max(other_cores - self.overhead_cores, 0.0)
+        headroom = self.target_percent / 100.0 * num_cpus - other_cores
+
+        return self.budget + self.gain * (headroom - self.budget)
+
+    def status(self) -> Dict[str, Any]:
+        """Get the controller state for reporting."""
+        status = super().status()
+        status.update(
+            {
+                "target_percent": self.target_percent,
+                "host_percent": round(self.host_percent, 1),
+                "other_cores": round(self.other_cores, 3),
+                "overhead_cores": round(self.overhead_cores, 3),
+            }
+        )
+        return status
+
+
+class PressureController(LoadController):
+    """
+    Holds CPU pressure stall (PSI 'some') at a target percentage.
+
+    The stall share is derived from the growth of the 'some total' counter
+    over each interval, which tracks the same quantity as avg10 without its
+    ten second smoothing lag. The budget is adjusted by an integral step
+    proportional to the error.
+    """
+
+    mode = "psi"
+
+    def __init__(
+        self,
+        loader,
+        target_percent: float,
+        cgroup: Optional[str] = None,
+        gain: float = 0.05,
+        interval: float = 1.0,
+        distribution: str = "spread",
+    ):
+        """
+        Initialize the pressure controller.
+
+        Args:
+            loader: CPULoader instance to drive
+            target_percent: Target 'some' CPU stall percentage (0-100)
+            cgroup: Use the cgroup's cpu.pressure instead of the host's
+            gain: Budget change in cores per percentage point of error and step
+            interval: Seconds between control steps
+            distribution: How the budget is distributed ('pack' or 'spread')
+        """
+        super().__init__(loader, interval, distribution)
+
+        if target_percent < 0 or target_percent > 100:
+            raise ValueError("Target percent must be between 0 and 100")
+
+        if gain <= 0:
+            raise ValueError("Gain must be positive")
+
+        self.target_percent = target_percent
+        self.cgroup = cgroup
+        self.gain = gain
+        self.stall_percent = 0.0
+        self.avg10 = 0.0
+
+        self._last_total = self._read_some()["total"]
+        self._last_time = time.monotonic()
+
+    def _read_some(self) -> Dict[str, float]:
+        """Read the 'some' line of the CPU pressure file."""
+        return sensors.read_pressure("cpu", self.cgroup)["some"]
+
+    def step(self) -> float:
+        """Measure the stall share and move the budget against the error."""
+        some = self._read_some()
+        now = time.monotonic()
+
+        elapsed = now - self._last_time
+        if elapsed <= 0:
+            return self.budget
+
+        self.stall_percent = (some["total"] - self._last_total) / elapsed / 1e4
+        self.avg10 = some["avg10"]
+        self._last_total = some["total"]
+        self._last_time = now
+
+        return self.budget + self.gain * (self.target_percent - self.stall_percent)
+
+    def status(self) -> Dict[str, Any]:
+        """Get the controller state for reporting."""
+        status = super().status()
+        status.update(
+            {
+                "cgroup": self.cgroup,
+                "target_percent": self.target_percent,
+                "stall_percent": round(self.stall_percent, 2),
+                "some_avg10": self.avg10,
+            }
+        )
+        return status
+
+
+class ThermalController(LoadController):
+    """
+    Holds the CPU package temperature at a set point with a PID controller.
+
+    The controller output is the fraction of all threads to load. Its rate
+    of change is limited, and at or above the hard ceiling the load is
+    dropped to zero immediately.
+    """
+
+    mode = "thermal"
+
+    def __init__(
+        self,
+        loader,
+        target_celsius: float,
+        ceiling_celsius: Optional[float] = None,
+        kp: float = 0.05,
+        ki: float = 0.005,
+        kd: float = 0.0,
+        max_rate: float = 0.05,
+        interval: float = 1.0,
+        distribution: str = "spread",
+    ):
+        """
+        Initialize the thermal controller.
+
+        Args:
+            loader: CPULoader instance to drive
+            target_celsius: Temperature to hold
+            ceiling_celsius: Hard limit, defaults to 10 degrees above target
+            kp: Proportional gain (load fraction per degree)
+            ki: Integral gain (load fraction per degree-second)
+            kd: Derivative gain (load fraction per degree/second)
+            max_rate: Maximum load fraction change per second
+            interval: Seconds between control steps
+            distribution: How the budget is distributed ('pack' or 'spread')
+        """
+        super().__init__(loader, interval, distribution)
+
+        if ceiling_celsius is None:
+            ceiling_celsius = target_celsius + 10.0
+
+        if ceiling_celsius <= target_celsius:
+            raise ValueError("Ceiling must be above the target temperature")
+
+        if kp < 0 or ki < 0 or kd < 0:
+            raise ValueError("PID gains must not be negative")
+
+        if max_rate <= 0:
+            raise ValueError("Maximum rate must be positive")
+
+        self.target_celsius = target_celsius
+        self.ceiling_celsius = ceiling_celsius
+        self.kp = kp
+        self.ki = ki
+        self.kd = kd
+        self.max_rate = max_rate
+        self.output = 0.0
+        self.integral = 0.0
+        self.ceiling_hit = False
+
+        self.temperature = self._read_temperature()
+        self._last_time = time.monotonic()
+
+    def _read_temperature(self) -> float:
+        """Read the cached package temperature."""
+        temperature = sensors.read_cpu_temperature(max_age=self.interval / 2)
+        if temperature is None:
+            raise OSError("No CPU temperature sensor available")
+        return temperature
+
+    def step(self) -> float:
+        """Run one PID update and return the rate-limited budget."""
+        temperature = self._read_temperature()
+        now = time.monotonic()
+        elapsed = now - self._last_time
+        if elapsed <= 0:
+            return self.budget
+
+        previous = self.temperature
+        self.temperature = temperature
+        self._last_time = now
+
+        self.ceiling_hit = temperature >= self.ceiling_celsius
+        if self.ceiling_hit:
+            self.integral = 0.0
+            self.output = 0.0
+            return 0.0
+
+        error = self.target_celsius - temperature
+        derivative = -(temperature - previous) / elapsed
+        output = self.kp * error + self.ki * self.integral + self.kd * derivative
+
+        # Only integrate while the output is not saturated (anti-windup)
+        if 0.0 < output < 1.0 or (output <= 0.0) != (error <= 0.0):
+            self.integral += error * elapsed
+
+        max_change = self.max_rate * elapsed
+        output = min(max(output, self.output - max_change), self.output + max_change)
+        self.output = min(max(output, 0.0), 1.0)
+
+        return self.output * self.loader.num_threads
+
+    def status(self) -> Dict[str, Any]:
+        """Get the controller state for reporting."""
+        status = super().status()
+        status.update(
+            {
+                "target_celsius": self.target_celsius,
+                "ceiling_celsius": self.ceiling_celsius,
+                "temperature": self.temperature,
+                "ceiling_hit": self.ceiling_hit,
+            }
+        )
+        return status
+
+
+class PowerController(LoadController):
+    """
+    Holds package power at a target wattage measured by the powercap
+    energy counters.
+
+    The budget follows an integral step proportional to the power error.
+    With an intensity ladder of computation types, the controller switches
+    to the next more intense kernel when all threads are fully loaded but
+    power is still below target, and back when the budget falls below a
+    quarter of the threads.
+    """
+
+    mode = "power"
+
+    def __init__(
+        self,
+        loader,
+        target_watts: float,
+        kernels: Optional[Sequence[int]] = None,
+        gain: Optional[float] = None,
+        interval: float = 1.0,
+        distribution: str = "spread",
+        powercap_root: Path = sensors.POWERCAP_ROOT,
+    ):
+        """
+        Initialize the power controller.
+
+        Args:
+            loader: CPULoader instance to drive
+            target_watts: Package power to hold in watts
+            kernels: Computation types ordered from least to most intense,
+                     None to keep the current computation type
+            gain: Budget change in cores per watt of error and step, defaults
+                  to half of all threads per target wattage
+            interval: Seconds between control steps
+            distribution: How the budget is distributed ('pack' or 'spread')
+            powercap_root: powercap class directory (for fake sysfs trees)
+        """
+        super().__init__(loader, interval, distribution)
+
+        if target_watts <= 0:
+            raise ValueError("Target watts must be positive")
+
+        if gain is None:
+            gain = 0.5 * loader.num_threads / target_watts
+
+        if gain <= 0:
+            raise ValueError("Gain must be positive")
+
+        self.target_watts = target_watts
+        self.kernels = list(kernels or [])
+        self.gain = gain
+        self.watts = 0.0
+        self.kernel_index = 0
+        self.meter = sensors.PowercapMeter(powercap_root)
+
+    def start(self):
+        """Switch to the least intense kernel of the ladder and start."""
+        if self.kernels:
+            self.set_kernel(self.kernels[self.kernel_index])
+        super().start()
+
+    def step(self) -> float:
+        """Measure package power and move the budget against the error."""
+        watts = self.meter.read_watts()
+        if watts is None:
+            return self.budget
+        self.watts = watts
+
+        budget = self.budget + self.gain * (self.target_watts - watts)
+        num_threads = self.loader.num_threads
+
+        if self.kernels:
+            if budget >= num_threads and self.kernel_index < len(self.kernels) - 1:
+                self.kernel_index += 1
+                self.set_kernel(self.kernels[self.kernel_index])
+            elif budget < num_threads / 4 and self.kernel_index > 0:
+                self.kernel_index -= 1
+                self.set_kernel(self.kernels[self.kernel_index])
+
+        return budget
+
+    def status(self) -> Dict[str, Any]:
+        """Get the controller state for reporting."""
+        status = super().status()
+        status.update(
+            {
+                "target_watts": self.target_watts,
+                "watts": round(self.watts, 2),
+                "computation_type": self.loader.get_computation_type_string(),
+            }
+        )
+        return status
+
+
+class MemoryBandwidthController(LoadController):
+    """
+    Holds an aggregate memory bandwidth by modulating the duty cycle of
+    workers running the streaming kernel.
+
+    Feedback comes from the stream kernel's own byte counters. Bandwidth
+    scales roughly with the budget until memory saturates, so the budget is
+    corrected multiplicatively by the ratio of target to measured bandwidth.
+    """
+
+    mode = "memory-bandwidth"
+
+    def __init__(
+        self,
+        loader,
+        target_gbps: float,
+        gain: float = 0.5,
+        interval: float = 0.5,
+        distribution: str = "spread",
+    ):
+        """
+        Initialize the memory bandwidth controller.
+
+        All threads run the streaming kernel while the controller is active.
+
+        Args:
+            loader: CPULoader instance to drive
+            target_gbps: Aggregate bandwidth to hold in GB/s (10^9 bytes)
+            gain: Exponent damping each multiplicative correction (0 < gain <= 1)
+            interval: Seconds between control steps
+            distribution: How the budget is distributed ('pack' or 'spread')
+        """
+        super().__init__(loader, interval, distribution)
+
+        if target_gbps <= 0:
+            raise ValueError("Target bandwidth must be positive")
+
+        if gain <= 0 or gain > 1:
+            raise ValueError("Gain must be between 0 (exclusive) and 1")
+
+        self.target_gbps = target_gbps
+        self.gain = gain
+        self.gbps = 0.0
+        self._last_bytes = 0
+        self._last_time = time.monotonic()
+
+    def start(self):
+        """Switch to the streaming kernel and start."""
+        self.set_kernel(ComputationType.MEMORY_STREAM)
+        self._last_bytes = self._read_bytes()
+        self._last_time = time.monotonic()
+        super().start()
+
+    def _read_bytes(self) -> int:
+        """Total bytes moved by all streaming workers."""
+        return sum(s["ops"] for s in self.loader.get_all_stats().values())
+
+    def step(self) -> float:
+        """Measure bandwidth and scale the budget towards the target."""
+        moved = self._read_bytes()
+        now = time.monotonic()
+        elapsed = now - self._last_time
+        if elapsed <= 0:
+            return self.budget
+
+        # Counters restart when threads are recreated
+        self.gbps = max(moved - self._last_bytes, 0) / elapsed / 1e9
+        self._last_bytes = moved
+        self._last_time = now
+
+        if self.gbps <= 0 or self.budget <= 0:
+            # Nothing to scale from yet, start with a tenth of the threads
+            return self.budget + 0.1 * self.loader.num_threads
+
+        ratio = min(max(self.target_gbps / self.gbps, 0.5), 2.0)
+        return self.budget * ratio**self.gain
+
+    def status(self) -> Dict[str, Any]:
+        """Get the controller state for reporting."""
+        status = super().status()
+        status.update(
+            {
+                "target_gbps": self.target_gbps,
+                "gbps": round(self.gbps, 3),
+            }
+        )
+        return status
+
+
+class YieldController(LoadController):
+    """
+    Harvests spare CPU next to a protected process or cgroup and yields it
+    back when the victim starts waiting for a CPU.
+
+    The victim's runqueue delay per timeslice is read from the schedstat of
+    all its threads. The budget follows additive increase / multiplicative
+    decrease with hysteresis: it grows while the delay is below the resume
+    threshold, is cut while the delay is above the backoff threshold and is
+    held in between.
+    """
+
+    mode = "yield"
+
+    def __init__(
+        self,
+        loader,
+        pid: Optional[int] = None,
+        cgroup: Optional[str] = None,
+        threshold_us: float = 500.0,
+        resume_us: Optional[float] = None,
+        increase: float = 0.25,
+        decrease: float = 0.5,
+        max_cores: Optional[float] = None,
+        interval: float = 0.5,
+        distribution: str = "spread",
+    ):
+        """
+        Initialize the yield controller.
+
+        Args:
+            loader: CPULoader instance to drive
+            pid: Process to protect (all of its threads)
+            cgroup: cgroup to protect, as name or path below /sys/fs/cgroup
+            threshold_us: Runqueue delay per timeslice that triggers a backoff
+            resume_us: Delay below which the budget grows again, defaults to
+                       half the threshold
+            increase: Budget increase in cores per step
+            decrease: Factor the budget is multiplied with on a backoff
+            max_cores: Upper limit of the harvested budget, defaults to all
+                       threads
+            interval: Seconds between control steps
+            distribution: How the budget is distributed ('pack' or 'spread')
+        """
+        super().__init__(loader, interval, distribution)
+
+        if (pid is None) == (cgroup is None):
+            raise ValueError("Exactly one of pid or cgroup must be given")
+
+        if pid is not None and pid == os.getpid():
+            raise ValueError("Cannot protect the loader's own process")
+
+        if resume_us is None:
+            resume_us = threshold_us / 2
+
+        if threshold_us <= 0 or resume_us < 0 or resume_us > threshold_us:
+            raise ValueError(
+                "Thresholds must satisfy 0 <= resume_us <= threshold_us, "
+                "threshold_us > 0"
+            )
+
+        if increase <= 0:
+            raise ValueError("Increase must be positive")
+
+        if decrease <= 0 or decrease >= 1:
+            raise ValueError("Decrease must be between 0 and 1 (exclusive)")
+
+        if max_cores is not None and max_cores <= 0:
+            raise ValueError("Maximum cores must be positive")
+
+        self.pid = pid
+        self.cgroup = cgroup
+        self.threshold_us = threshold_us
+        self.resume_us = resume_us
+        self.increase = increase
+        self.decrease = decrease
+        self.max_cores = max_cores if max_cores is not None else loader.num_threads
+        self.delay_us = 0.0
+        self.backoffs = 0
+        self.backing_off = False
+
+        # Time integral of the budget, to report the average harvested cores
+        self._core_seconds = 0.0
+        self._start_time = time.monotonic()
+        self._last_time = self._start_time
+
+        self._last_stats = self._read_stats()
+
+    def _read_stats(self) -> Dict[int, Tuple[int, int, int]]:
+        """Read the schedstat of every thread of the victim."""
+        stats = sensors.read_task_schedstats(self.pid, self.cgroup)
+        if not stats:
+            target = self.pid if self.pid is not None else self.cgroup
+            raise OSError(f"No threads to protect in '{target}'")
+        return stats
+
+    def step(self) -> float:
+        """Measure the victim's runqueue delay and apply AIMD to the budget."""
+        stats = self._read_stats()
+        now = time.monotonic()
+        # The budget applied since the previous step, for the measured time
+        # rather than the nominal interval so that late steps count in full
+        self._core_seconds += self.budget * (now - self._last_time)
+        self._last_time = now
+
+        # Only threads present in both samples give meaningful deltas
+        wait_ns = 0
+        timeslices = 0
+        for tid, (_, wait, slices) in stats.items():
+            if tid in self._last_stats:
+                _, last_wait, last_slices = self._last_stats[tid]
+                wait_ns += wait - last_wait
+                timeslices += slices - last_slices
+        self._last_stats = stats
+
+        # An idle victim ran no timeslices and did not wait
+        self.delay_us = wait_ns / timeslices / 1e3 if timeslices > 0 else 0.0
+
+        if self.delay_us > self.threshold_us:
+            if not self.backing_off:
+                self.backoffs += 1
+            self.backing_off = True
+            return self.budget * self.decrease
+
+        if self.delay_us < self.resume_us:
+            self.backing_off = False
+            return min(self.budget + self.increase, self.max_cores)
+
+        return self.budget
+
+    def status(self) -> Dict[str, Any]:
+        """Get the controller state for reporting."""
+        status = super().status()
+        elapsed = time.monotonic() - self._start_time
+        status.update(
+            {
+                "pid": self.pid,
+                "cgroup": self.cgroup,
+                "threshold_us": self.threshold_us,
+                "resume_us": self.resume_us,
+                "delay_us_per_timeslice": round(self.delay_us, 1),
+                "backing_off": self.backing_off,
+                "backoffs": self.backoffs,
+                "average_harvested_cores": round(
+                    self._core_seconds / elapsed if elapsed > 0 else 0.0, 3
+                ),
+            }
+        )
+        return status
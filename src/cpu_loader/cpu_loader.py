@@ -5,7 +5,10 @@ Uses a C extension for efficient CPU load generation.
 """
 
 import multiprocessing
-from typing import Dict
+import os
+import statistics
+import time
+from typing import Any, Dict, List, Optional, Sequence, Tuple, Union
 
 try:
     from cpu_loader import cpu_loader_core  # type: ignore[attr-defined]
@@ -15,6 +18,16 @@ except ImportError:
         "uv pip install -e ."
     )
 
+# Samples that must match a cached throughput to skip the rest of a warm-up
+CALIBRATION_MATCH_SAMPLES = 3
+
+# Granularity of the cache kernel's footprint
+CACHE_LINE_BYTES = 64
+
+# Largest cache footprint in multiples of the last-level cache, beyond that
+# the cache kernel only streams through memory
+CACHE_MAX_LLC_MULTIPLE = 4
+
 
 class ComputationType:
     """Enumeration for different computation types."""
@@ -24,6 +37,19 @@ class ComputationType:
     PRIME_NUMBERS = 2
     MATRIX_MULTIPLY = 3
     FIBONACCI = 4
+    MEMORY_STREAM = 5
+    CACHE_POLLUTE = 6
+
+    # What one "op" means for each kernel in throughput mode and statistics
+    OP_UNITS = {
+        BUSY_WAIT: "timer polls",
+        PI_CALCULATION: "series terms",
+        PRIME_NUMBERS: "candidates tested",
+        MATRIX_MULTIPLY: "4x4 matrix products",
+        FIBONACCI: "arithmetic steps",
+        MEMORY_STREAM: "bytes moved",
+        CACHE_POLLUTE: "cache lines dirtied",
+    }
 
     @classmethod
     def from_string(cls, compute_str: str) -> int:
@@ -34,6 +60,8 @@ class ComputationType:
             "primes": cls.PRIME_NUMBERS,
             "matrix": cls.MATRIX_MULTIPLY,
             "fibonacci": cls.FIBONACCI,
+            "stream": cls.MEMORY_STREAM,
+            "cache": cls.CACHE_POLLUTE,
         }
 
         compute_str = compute_str.lower().strip()
@@ -54,6 +82,8 @@ class ComputationType:
             cls.PRIME_NUMBERS: "primes",
             cls.MATRIX_MULTIPLY: "matrix",
             cls.FIBONACCI: "fibonacci",
+            cls.MEMORY_STREAM: "stream",
+            cls.CACHE_POLLUTE: "cache",
         }
 
         if compute_type not in type_map:
@@ -62,9 +92,41 @@ class ComputationType:
         return type_map[compute_type]
 
 
+class Waveform:
+    """Enumeration for load waveforms modulating a thread's base load."""
+
+    CONSTANT = 0
+    SINE = 1
+    SQUARE = 2
+    TRIANGLE = 3
+    SAWTOOTH = 4
+
+    @classmethod
+    def from_string(cls, waveform_str: str) -> int:
+        """Convert string representation to waveform integer."""
+        waveform_map = {
+            "constant": cls.CONSTANT,
+            "sine": cls.SINE,
+            "square": cls.SQUARE,
+            "triangle": cls.TRIANGLE,
+            "sawtooth": cls.SAWTOOTH,
+        }
+
+        waveform_str = waveform_str.lower().strip()
+        if waveform_str not in waveform_map:
+            available = ", ".join(waveform_map.keys())
+            raise ValueError(
+                f"Invalid waveform '{waveform_str}'. Available: {available}"
+            )
+
+        return waveform_map[waveform_str]
+
+
 class CPULoader:
     """Manages CPU load generation across multiple threads using C extension."""
 
+    BUDGET_DISTRIBUTIONS = ("pack", "spread")
+
     def __init__(self, num_threads: int = None):
         """
         Initialize the CPU loader.
@@ -76,6 +138,10 @@ class CPULoader:
             num_threads = multiprocessing.cpu_count()
 
         self.num_threads = num_threads
+        self.controller = None
+        self.victim = None
+        self.ready = True
+        self.warmup_report: Optional[Dict[str, Any]] = None
         cpu_loader_core.init_loader(num_threads)
 
     def set_thread_load(self, thread_id: int, load_percent: float):
@@ -107,6 +173,27 @@ class CPULoader:
         for thread_id in range(self.num_threads):
             cpu_loader_core.set_thread_load(thread_id, load_percent)
 
+    def set_core_budget(self, cores: float, distribution: str = "spread"):
+        """
+        Set the total load as a number of cores and distribute it.
+
+        Args:
+            cores: Total load in cores (0.0 to num_threads), e.g. 3.7
+            distribution: 'pack' for as many threads at 100% as possible plus
+                          one partial thread, 'spread' for an even share on
+                          every thread
+        """
+        if distribution not in self.BUDGET_DISTRIBUTIONS:
+            available = ", ".join(self.BUDGET_DISTRIBUTIONS)
+            raise ValueError(
+                f"Invalid distribution '{distribution}'. Available: {available}"
+            )
+
+        if cores < 0 or cores > self.num_threads:
+            raise ValueError(f"Core budget must be between 0 and {self.num_threads}")
+
+        cpu_loader_core.set_core_budget(cores, distribution == "spread")
+
     def get_thread_load(self, thread_id: int) -> float:
         """
         Get the current load setting for a specific thread.
@@ -131,13 +218,174 @@ class CPULoader:
         """
         return cpu_loader_core.get_all_loads()
 
+    def set_thread_ops_target(self, thread_id: int, ops_per_sec: float):
+        """
+        Set a throughput target for a specific thread.
+
+        The thread paces kernel batches to deliver this many ops per second
+        instead of running a fixed duty cycle. The CPU time this costs is
+        reported by get_thread_stats(). Setting a load percentage with
+        set_thread_load() switches the thread back to duty-cycle mode.
+
+        Args:
+            thread_id: ID of the thread (0 to num_threads-1)
+            ops_per_sec: Target rate in kernel ops per second (0 disables)
+        """
+        if thread_id < 0 or thread_id >= self.num_threads:
+            raise ValueError(f"Thread ID must be between 0 and {self.num_threads - 1}")
+
+        if ops_per_sec < 0:
+            raise ValueError("Ops target must not be negative")
+
+        cpu_loader_core.set_thread_ops_target(thread_id, ops_per_sec)
+
+    def set_all_ops_targets(self, ops_per_sec: float):
+        """
+        Set the same throughput target for all threads.
+
+        Args:
+            ops_per_sec: Target rate per thread in kernel ops per second
+        """
+        if ops_per_sec < 0:
+            raise ValueError("Ops target must not be negative")
+
+        for thread_id in range(self.num_threads):
+            cpu_loader_core.set_thread_ops_target(thread_id, ops_per_sec)
+
+    def set_thread_cycles_target(self, thread_id: int, cycles_per_sec: float):
+        """
+        Set a core cycles target for a specific thread.
+
+        The thread runs its kernel until it has consumed this many core
+        cycles per second, read from the hardware cycle counter (perf). The
+        work delivered then stays constant when turbo engages or disengages
+        and the CPU percentage floats instead. Without a counter, cycles are
+        estimated from CPU time at the reference frequency, which degrades
+        to a CPU time budget. Setting a load percentage with
+        set_thread_load() switches the thread back to duty-cycle mode.
+
+        Args:
+            thread_id: ID of the thread (0 to num_threads-1)
+            cycles_per_sec: Target core cycles per second (0 disables)
+
+        Raises:
+            ValueError: If there is neither a cycle counter nor a reference
+                        frequency (see set_reference_frequency())
+        """
+        if thread_id < 0 or thread_id >= self.num_threads:
+            raise ValueError(f"Thread ID must be between 0 and {self.num_threads - 1}")
+
+        if cycles_per_sec < 0:
+            raise ValueError("Cycles target must not be negative")
+
+        if cycles_per_sec > 0:
+            self._ensure_reference_frequency()
+        cpu_loader_core.set_thread_cycles_target(thread_id, cycles_per_sec)
+
+    def set_all_cycles_targets(self, cycles_per_sec: float):
+        """
+        Set the same core cycles target for all threads.
+
+        Args:
+            cycles_per_sec: Target core cycles per second per thread
+        """
+        if cycles_per_sec < 0:
+            raise ValueError("Cycles target must not be negative")
+
+        if cycles_per_sec > 0:
+            self._ensure_reference_frequency()
+        for thread_id in range(self.num_threads):
+            cpu_loader_core.set_thread_cycles_target(thread_id, cycles_per_sec)
+
+    def set_reference_frequency(self, hz: float):
+        """
+        Set the nominal core frequency used to estimate cycles from CPU time
+        on threads without a hardware cycle counter.
+
+        Args:
+            hz: Frequency in Hz
+        """
+        if hz <= 0:
+            raise ValueError("Reference frequency must be positive")
+
+        cpu_loader_core.set_reference_frequency(hz)
+
+    def get_reference_frequency(self) -> Optional[float]:
+        """
+        Get the nominal core frequency used for cycle estimates.
+
+        Returns:
+            Frequency in Hz, or None if it has not been determined yet
+        """
+        return cpu_loader_core.get_reference_frequency() or None
+
+    def _ensure_reference_frequency(self):
+        """
+        Look up the reference frequency once if it has not been set.
+
+        Raises:
+            ValueError: If there is neither a hardware cycle counter nor a
+                        reference frequency, so cycles cannot be counted
+        """
+        if cpu_loader_core.get_reference_frequency() > 0:
+            return
+
+        # Imported here so that the loader itself does not depend on psutil
+        from cpu_loader.sensors import read_reference_frequency
+
+        hz = read_reference_frequency()
+        if hz is not None:
+            cpu_loader_core.set_reference_frequency(hz)
+        elif not cpu_loader_core.has_cycle_counter():
+            raise ValueError(
+                "No cycle counter and no reference frequency to count cycles, "
+                "set one with set_reference_frequency()"
+            )
+
+    def get_thread_stats(self, thread_id: int) -> Dict[str, float]:
+        """
+        Get runtime statistics for a specific thread.
+
+        Args:
+            thread_id: ID of the thread
+
+        Returns:
+            Dictionary with total ops, busy_ns, cycles, cpu_time_ns (thread
+            CPU time) and user_time_ns (its user-space part) counters, the
+            smoothed achieved_load (percent of each cycle spent computing),
+            ops_per_sec, the configured
+            target_ops_per_sec, computation_type, cache_footprint (bytes),
+            the consumed cpu_cycles, the smoothed cpu_cycles_per_sec, the
+            configured target_cpu_cycles_per_sec and whether the cycles come
+            from a hardware counter (cycles_counted). load_seq counts load
+            and target changes, applied_seq is the one the worker runs with
+            and applied_ns the CLOCK_MONOTONIC time it picked that up. tid
+            is the kernel thread ID and cycle_ns the duty cycle period.
+            cycle_jitter_hist counts cycles by how far their duration was off
+            the period (bucket 0 exact, bucket b within [2^(b-1), 2^b) ns),
+            with the cycle_jitter_sum_ns and cycle_jitter_max_ns totals.
+        """
+        if thread_id < 0 or thread_id >= self.num_threads:
+            raise ValueError(f"Thread ID must be between 0 and {self.num_threads - 1}")
+
+        return cpu_loader_core.get_thread_stats(thread_id)
+
+    def get_all_stats(self) -> Dict[int, Dict[str, float]]:
+        """
+        Get runtime statistics for all threads.
+
+        Returns:
+            Dictionary mapping thread ID to its statistics
+        """
+        return cpu_loader_core.get_all_stats()
+
     def get_num_threads(self) -> int:
         """Get the number of threads."""
         return cpu_loader_core.get_num_threads()
 
     def set_num_threads(self, num_threads: int):
         """
-        Change the number of threads.
+        Change the number of threads. Any worker groups are removed.
 
         Args:
             num_threads: New number of threads
@@ -148,6 +396,330 @@ class CPULoader:
         self.num_threads = num_threads
         cpu_loader_core.init_loader(num_threads)
 
+    def define_groups(self, groups: Dict[str, int]):
+        """
+        Replace all threads with named groups of threads.
+
+        Threads are numbered consecutively in the order the groups are given,
+        e.g. {"frontend": 8, "batch": 16} creates threads 0-7 and 8-23.
+        All previous loads and per-thread settings are reset.
+
+        Args:
+            groups: Mapping of group name to number of threads
+        """
+        if not groups:
+            raise ValueError("At least one group is required")
+
+        for name, count in groups.items():
+            if count <= 0:
+                raise ValueError(f"Group '{name}' needs a positive thread count")
+
+        cpu_loader_core.define_groups(list(groups.items()))
+        self.num_threads = sum(groups.values())
+
+    def get_groups(self) -> Dict[str, List[int]]:
+        """
+        Get the defined groups.
+
+        Returns:
+            Dictionary mapping group name to its thread IDs
+        """
+        return cpu_loader_core.get_groups()
+
+    def get_group_threads(self, name: str) -> List[int]:
+        """
+        Get the thread IDs of a group.
+
+        Args:
+            name: Group name
+
+        Returns:
+            List of thread IDs in the group
+        """
+        groups = self.get_groups()
+        if name not in groups:
+            raise ValueError(f"Unknown group '{name}'")
+
+        return groups[name]
+
+    def set_group_load(self, name: str, load_percent: float):
+        """
+        Set the same CPU load for all threads of a group.
+
+        Args:
+            name: Group name
+            load_percent: Load percentage (0.0 to 100.0)
+        """
+        if load_percent < 0 or load_percent > 100:
+            raise ValueError("Load percent must be between 0 and 100")
+
+        for thread_id in self.get_group_threads(name):
+            cpu_loader_core.set_thread_load(thread_id, load_percent)
+
+    def set_group_ops_target(self, name: str, ops_per_sec: float):
+        """
+        Set a throughput target for a group, split evenly across its threads.
+
+        Args:
+            name: Group name
+            ops_per_sec: Target rate for the whole group in kernel ops per second
+        """
+        if ops_per_sec < 0:
+            raise ValueError("Ops target must not be negative")
+
+        thread_ids = self.get_group_threads(name)
+        for thread_id in thread_ids:
+            cpu_loader_core.set_thread_ops_target(
+                thread_id, ops_per_sec / len(thread_ids)
+            )
+
+    def set_group_computation_type(self, name: str, compute_type: Union[int, str]):
+        """
+        Set the computation type for all threads of a group.
+
+        Args:
+            name: Group name
+            compute_type: ComputationType constant or its string representation
+        """
+        if isinstance(compute_type, str):
+            compute_type = ComputationType.from_string(compute_type)
+
+        for thread_id in self.get_group_threads(name):
+            cpu_loader_core.set_thread_computation_type(thread_id, compute_type)
+
+    def set_group_affinity(self, name: str, cpus: Optional[Sequence[int]]):
+        """
+        Pin all threads of a group to a set of CPUs (Linux only).
+
+        Args:
+            name: Group name
+            cpus: CPU numbers the group may run on, None or empty for all CPUs
+        """
+        for thread_id in self.get_group_threads(name):
+            cpu_loader_core.set_thread_affinity(thread_id, list(cpus or []))
+
+    def set_group_priority(self, name: str, nice: int):
+        """
+        Set the nice value of all threads of a group (Linux only).
+
+        Lowering the nice value below the current one needs CAP_SYS_NICE.
+
+        Args:
+            name: Group name
+            nice: Nice value (-20 to 19)
+        """
+        if nice < -20 or nice > 19:
+            raise ValueError("Nice value must be between -20 and 19")
+
+        for thread_id in self.get_group_threads(name):
+            cpu_loader_core.set_thread_priority(thread_id, nice)
+
+    def set_group_waveform(
+        self,
+        name: str,
+        waveform: Union[int, str],
+        period_ms: float = 1000.0,
+        amplitude_percent: float = 0.0,
+    ):
+        """
+        Modulate the load of all threads of a group with a waveform.
+
+        The waveform swings the duty-cycle load by +/- amplitude_percent around
+        the base load set with set_group_load(), clamped to 0-100%.
+
+        Args:
+            name: Group name
+            waveform: Waveform constant or string (constant, sine, square,
+                      triangle, sawtooth)
+            period_ms: Waveform period in milliseconds
+            amplitude_percent: Swing around the base load in percent
+        """
+        if isinstance(waveform, str):
+            waveform = Waveform.from_string(waveform)
+
+        if amplitude_percent < 0 or amplitude_percent > 100:
+            raise ValueError("Amplitude must be between 0 and 100")
+
+        for thread_id in self.get_group_threads(name):
+            cpu_loader_core.set_thread_waveform(
+                thread_id, waveform, period_ms, amplitude_percent
+            )
+
+    def set_group_settings(
+        self,
+        name: str,
+        load_percent: Optional[float] = None,
+        ops_per_sec: Optional[float] = None,
+        computation_type: Optional[Union[int, str]] = None,
+        cpus: Optional[Sequence[int]] = None,
+        nice: Optional[int] = None,
+        waveform: Optional[Union[int, str]] = None,
+        period_ms: float = 1000.0,
+        amplitude_percent: float = 0.0,
+    ):
+        """
+        Change several settings of a group at once.
+
+        All settings are validated before any is applied, so invalid input
+        leaves the group unchanged. Affinity and priority are applied first,
+        as only the kernel can refuse them (OSError).
+
+        Args:
+            name: Group name
+            load_percent: Load percentage for every thread
+            ops_per_sec: Throughput target for the whole group
+            computation_type: ComputationType constant or string
+            cpus: CPUs to pin the group to, empty for all CPUs
+            nice: Nice value (-20 to 19)
+            waveform: Waveform constant or string, with its period_ms and
+                      amplitude_percent
+        """
+        self.get_group_threads(name)
+
+        if load_percent is not None and (load_percent < 0 or load_percent > 100):
+            raise ValueError("Load percent must be between 0 and 100")
+
+        if ops_per_sec is not None and ops_per_sec < 0:
+            raise ValueError("Ops target must not be negative")
+
+        if isinstance(computation_type, str):
+            computation_type = ComputationType.from_string(computation_type)
+
+        if cpus is not None:
+            num_cpus = os.sysconf("SC_NPROCESSORS_CONF")
+            for cpu in cpus:
+                if cpu < 0 or cpu >= num_cpus:
+                    raise ValueError(f"CPU {cpu} does not exist")
+
+        if nice is not None and (nice < -20 or nice > 19):
+            raise ValueError("Nice value must be between -20 and 19")
+
+        if isinstance(waveform, str):
+            waveform = Waveform.from_string(waveform)
+        if waveform is not None:
+            if amplitude_percent < 0 or amplitude_percent > 100:
+                raise ValueError("Amplitude must be between 0 and 100")
+            min_period_ms = self.get_cycle_time() * 2
+            if waveform != Waveform.CONSTANT and period_ms < min_period_ms:
+                raise ValueError(
+                    f"Waveform period must be at least {min_period_ms:g} ms"
+                )
+
+        if cpus is not None:
+            self.set_group_affinity(name, cpus)
+        if nice is not None:
+            self.set_group_priority(name, nice)
+        if computation_type is not None:
+            self.set_group_computation_type(name, computation_type)
+        if waveform is not None:
+            self.set_group_waveform(name, waveform, period_ms, amplitude_percent)
+        if load_percent is not None:
+            self.set_group_load(name, load_percent)
+        if ops_per_sec is not None:
+            self.set_group_ops_target(name, ops_per_sec)
+
+    def set_cache_footprint(
+        self,
+        footprint_mb: float,
+        group: Optional[str] = None,
+        intensity_percent: float = 1.0,
+    ):
+        """
+        Keep a total number of megabytes of cache dirty with the cache kernel.
+
+        The footprint is split evenly across the threads, which are switched
+        to the cache kernel. Each thread writes one byte per cache line of its
+        share at least once every cycle, which keeps the lines resident in the
+        last-level cache at minimal CPU cost. The intensity is the share of
+        each cycle spent sweeping: higher intensities refresh the lines more
+        often and hold them against more aggressive neighbors. A footprint of
+        0 stops the threads.
+
+        Args:
+            footprint_mb: Total footprint in MiB
+            group: Only use the threads of this group
+            intensity_percent: Share of each cycle spent sweeping (0-100],
+                               at least one sweep per cycle
+
+        Raises:
+            ValueError: If the footprint exceeds CACHE_MAX_LLC_MULTIPLE times
+                        the last-level cache
+        """
+        if footprint_mb < 0:
+            raise ValueError("Cache footprint must not be negative")
+
+        # Imported here so that the loader itself does not depend on psutil
+        from cpu_loader.sensors import read_llc_bytes
+
+        llc = read_llc_bytes()
+        if llc is not None:
+            max_mb = CACHE_MAX_LLC_MULTIPLE * llc / (1024 * 1024)
+            if footprint_mb > max_mb:
+                raise ValueError(
+                    f"Cache footprint must not exceed {max_mb:g} MiB "
+                    f"({CACHE_MAX_LLC_MULTIPLE} times the last-level cache)"
+                )
+
+        if intensity_percent <= 0 or intensity_percent > 100:
+            raise ValueError("Intensity must be between 0 (exclusive) and 100")
+
+        if group is not None:
+            thread_ids = self.get_group_threads(group)
+        else:
+            thread_ids = list(range(self.num_threads))
+
+        share = int(footprint_mb * 1024 * 1024 / len(thread_ids))
+        for thread_id in thread_ids:
+            if footprint_mb == 0:
+                cpu_loader_core.set_thread_load(thread_id, 0.0)
+                continue
+
+            cpu_loader_core.set_thread_cache_footprint(
+                thread_id, max(share, CACHE_LINE_BYTES)
+            )
+            cpu_loader_core.set_thread_computation_type(
+                thread_id, ComputationType.CACHE_POLLUTE
+            )
+            cpu_loader_core.set_thread_load(thread_id, intensity_percent)
+
+    def get_cache_footprint(self) -> Dict[str, Optional[float]]:
+        """
+        Get the cache footprint of the threads running the cache kernel.
+
+        The actual LLC occupancy is not measured. resident_bound_mb is only
+        an upper bound of it; ns_per_line shows how much of it is lost.
+
+        Returns:
+            Dictionary with the configured footprint_mb, the llc_mb of the
+            host (None if unknown), resident_bound_mb (footprint capped at
+            the LLC size) and ns_per_line, the average time to dirty one
+            line, which rises when lines are evicted between sweeps
+        """
+        footprint = 0
+        ops = 0
+        busy_ns = 0
+        loads = self.get_all_loads()
+        for thread_id, stats in self.get_all_stats().items():
+            if stats["computation_type"] != ComputationType.CACHE_POLLUTE:
+                continue
+            if loads[thread_id] <= 0:
+                continue
+            footprint += stats["cache_footprint"]
+            ops += stats["ops"]
+            busy_ns += stats["busy_ns"]
+
+        # Imported here so that the loader itself does not depend on psutil
+        from cpu_loader.sensors import read_llc_bytes
+
+        llc = read_llc_bytes()
+        bound = min(footprint, llc) if llc is not None else footprint
+        return {
+            "footprint_mb": footprint / (1024 * 1024),
+            "llc_mb": llc / (1024 * 1024) if llc is not None else None,
+            "resident_bound_mb": bound / (1024 * 1024),
+            "ns_per_line": busy_ns / ops if ops else None,
+        }
+
     def set_computation_type(self, compute_type: int):
         """
         Set the computation type for CPU load generation.
@@ -166,13 +738,78 @@ class CPULoader:
         """
         return cpu_loader_core.get_computation_type()
 
+    def save_loads(self) -> Dict[int, Tuple[float, float, float]]:
+        """
+        Snapshot the load settings for restore_loads().
+
+        Returns:
+            Dictionary mapping thread ID to its load percentage, ops target
+            and cycles target
+        """
+        loads = self.get_all_loads()
+        return {
+            thread_id: (
+                loads[thread_id],
+                stats["target_ops_per_sec"],
+                stats["target_cpu_cycles_per_sec"],
+            )
+            for thread_id, stats in self.get_all_stats().items()
+        }
+
+    def restore_loads(self, saved: Dict[int, Tuple[float, float, float]]):
+        """
+        Restore load settings saved with save_loads().
+
+        Args:
+            saved: Return value of save_loads(). Threads that no longer
+                   exist are skipped.
+        """
+        for thread_id, (load, ops_per_sec, cycles_per_sec) in saved.items():
+            if thread_id >= self.num_threads:
+                continue
+            cpu_loader_core.set_thread_load(thread_id, load)
+            if cycles_per_sec > 0:
+                cpu_loader_core.set_thread_cycles_target(thread_id, cycles_per_sec)
+            elif ops_per_sec > 0:
+                cpu_loader_core.set_thread_ops_target(thread_id, ops_per_sec)
+
+    def save_kernels(self) -> Tuple[int, Dict[int, int]]:
+        """
+        Snapshot the computation types for restore_kernels().
+
+        Groups and cache polluter threads run their own kernels next to the
+        global one, so every thread's kernel is kept.
+
+        Returns:
+            The global computation type and the one of every thread
+        """
+        kernels = {
+            thread_id: stats["computation_type"]
+            for thread_id, stats in self.get_all_stats().items()
+        }
+        return self.get_computation_type(), kernels
+
+    def restore_kernels(self, saved: Tuple[int, Dict[int, int]]):
+        """
+        Restore computation types saved with save_kernels().
+
+        Args:
+            saved: Return value of save_kernels(). Threads that no longer
+                   exist are skipped.
+        """
+        global_type, kernels = saved
+        cpu_loader_core.set_computation_type(global_type)
+        for thread_id, compute_type in kernels.items():
+            if thread_id < self.num_threads and compute_type != global_type:
+                cpu_loader_core.set_thread_computation_type(thread_id, compute_type)
+
     def set_computation_type_from_string(self, compute_str: str):
         """
         Set the computation type from string representation.
 
         Args:
             compute_str: Computation type as string (e.g., 'pi', 'primes',
-                        'matrix', 'fibonacci', 'busy-wait')
+                        'matrix', 'fibonacci', 'stream', 'busy-wait')
         """
         compute_type = ComputationType.from_string(compute_str)
         self.set_computation_type(compute_type)
@@ -187,6 +824,279 @@ class CPULoader:
         compute_type = self.get_computation_type()
         return ComputationType.to_string(compute_type)
 
+    def set_phase_stagger(self, enabled: bool):
+        """
+        Spread worker cycle phases evenly across the cycle period.
+
+        With staggering enabled, worker i starts its cycles at an offset of
+        i/num_threads of the period, so partial loads add up to a flat
+        aggregate instead of beating against each other.
+
+        Args:
+            enabled: True to stagger worker phases, False for free-running cycles
+        """
+        cpu_loader_core.set_phase_stagger(enabled)
+
+    def get_phase_stagger(self) -> bool:
+        """
+        Get whether worker phases are staggered.
+
+        Returns:
+            True if phase staggering is enabled
+        """
+        return cpu_loader_core.get_phase_stagger()
+
+    def set_cycle_time(self, cycle_ms: float):
+        """
+        Set the duty cycle period of all threads.
+
+        Shorter cycles follow load changes faster and spread the load more
+        evenly, at the cost of more wakeups; longer cycles hold the CPU in
+        longer bursts.
+
+        Args:
+            cycle_ms: Cycle period in milliseconds (1-100, default 10)
+        """
+        cpu_loader_core.set_cycle_time(int(cycle_ms * 1e6))
+
+    def get_cycle_time(self) -> float:
+        """
+        Get the duty cycle period.
+
+        Returns:
+            Cycle period in milliseconds
+        """
+        return cpu_loader_core.get_cycle_time() / 1e6
+
+    def warmup(
+        self,
+        kernels: Optional[Sequence[Union[int, str]]] = None,
+        max_seconds: float = 10.0,
+        cv_threshold: float = 0.03,
+        window: int = 10,
+        sample_interval: float = 0.1,
+        cache=None,
+    ) -> Dict[str, Any]:
+        """
+        Warm up before measurements are taken.
+
+        Kernel buffers of all threads are prefaulted first. Then every kernel
+        runs at 100% on all threads until its aggregate throughput is stable,
+        i.e. the coefficient of variation of the last `window` samples is at
+        most cv_threshold, or max_seconds have passed. This takes page faults,
+        cold caches, frequency ramp-up and thread start skew out of the
+        first measured cycles. Loads, ops and cycles targets and the
+        computation types of all threads are restored afterwards. is_ready()
+        is False while the warm-up runs.
+
+        With a calibration cache, a kernel whose throughput at this thread
+        count is cached only has to match it: it is done as soon as the last
+        few samples are within twice cv_threshold of the cached ops/s. Stable
+        results are stored back and the cache is saved after is_ready()
+        turns True again.
+
+        Args:
+            kernels: Computation types to warm up, defaults to the current one
+            max_seconds: Time limit per kernel
+            cv_threshold: Coefficient of variation that counts as stable
+            window: Number of throughput samples the variation is taken over
+            sample_interval: Seconds between throughput samples
+            cache: Optional CalibrationCache (see cpu_loader.calibration)
+
+        Returns:
+            Dictionary with the total seconds and, per kernel, the seconds it
+            took, whether it became stable, whether it matched the cache, the
+            final cv and ops_per_sec
+        """
+        if max_seconds <= 0 or sample_interval <= 0:
+            raise ValueError("Time limit and sample interval must be positive")
+
+        if cv_threshold <= 0:
+            raise ValueError("CV threshold must be positive")
+
+        if window < 2:
+            raise ValueError("Window must hold at least 2 samples")
+
+        if self.controller is not None:
+            raise ValueError("Stop closed-loop control before warming up")
+
+        if kernels is None:
+            kernels = [self.get_computation_type()]
+        kernel_types = [
+            ComputationType.from_string(k) if isinstance(k, str) else k for k in kernels
+        ]
+
+        previous_loads = self.save_loads()
+        previous_kernels = self.save_kernels()
+
+        self.ready = False
+        start = time.monotonic()
+        results = []
+        try:
+            cpu_loader_core.prefault_workers()
+            prefault_seconds = time.monotonic() - start
+
+            for kernel in kernel_types:
+                cpu_loader_core.set_computation_type(kernel)
+                self.set_all_loads(100.0)
+                expected = None
+                if cache is not None:
+                    expected = cache.lookup(
+                        ComputationType.to_string(kernel), self.num_threads
+                    )
+                results.append(
+                    self._run_until_stable(
+                        kernel,
+                        max_seconds,
+                        cv_threshold,
+                        window,
+                        sample_interval,
+                        expected,
+                    )
+                )
+
+            self.warmup_report = {
+                "seconds": round(time.monotonic() - start, 3),
+                "prefault_seconds": round(prefault_seconds, 3),
+                "kernels": results,
+            }
+        finally:
+            self.restore_kernels(previous_kernels)
+            self.restore_loads(previous_loads)
+            self.ready = True
+
+        # Refresh the cache only now, the loader is usable in the meantime
+        if cache is not None:
+            for result in results:
+                if result["stable"]:
+                    cache.store(
+                        result["kernel"], self.num_threads, result["ops_per_sec"]
+                    )
+            cache.save()
+
+        return self.warmup_report
+
+    def _run_until_stable(
+        self,
+        kernel: int,
+        max_seconds: float,
+        cv_threshold: float,
+        window: int,
+        sample_interval: float,
+        expected: Optional[float] = None,
+    ) -> Dict[str, Any]:
+        """
+        Sample aggregate throughput until it is stable, matches the expected
+        (cached) throughput or time runs out.
+        """
+        start = time.monotonic()
+        last_ops = sum(s["ops"] for s in self.get_all_stats().values())
+        last_time = start
+        samples: List[float] = []
+        cv = None
+        cached = False
+
+        while time.monotonic() - start < max_seconds:
+            time.sleep(sample_interval)
+            ops = sum(s["ops"] for s in self.get_all_stats().values())
+            now = time.monotonic()
+            samples.append((ops - last_ops) / (now - last_time))
+            last_ops = ops
+            last_time = now
+
+            if expected and len(samples) >= CALIBRATION_MATCH_SAMPLES:
+                recent = samples[-CALIBRATION_MATCH_SAMPLES:]
+                if all(abs(s / expected - 1.0) <= 2 * cv_threshold for s in recent):
+                    cv = statistics.pstdev(recent) / statistics.fmean(recent)
+                    cached = True
+                    break
+
+            if len(samples) >= window:
+                recent = samples[-window:]
+                mean = statistics.fmean(recent)
+                cv = statistics.pstdev(recent) / mean if mean > 0 else None
+                if cv is not None and cv <= cv_threshold:
+                    break
+
+        stable = cached or (cv is not None and cv <= cv_threshold)
+        return {
+            "kernel": ComputationType.to_string(kernel),
+            "seconds": round(time.monotonic() - start, 3),
+            "stable": stable,
+            "cached": cached,
+            "cv": round(cv, 4) if cv is not None else None,
+            "ops_per_sec": round(samples[-1], 1) if samples else None,
+        }
+
+    def is_ready(self) -> bool:
+        """Return False while a warm-up is running."""
+        return self.ready
+
+    def start_controller(self, controller):
+        """
+        Hand load control to a closed-loop controller.
+
+        Any previously active controller is stopped first. While a controller
+        is active it overwrites manually set loads on every step.
+
+        Args:
+            controller: LoadController instance (see cpu_loader.controllers)
+        """
+        self.stop_controller()
+        self.controller = controller
+        controller.start()
+
+    def stop_controller(self):
+        """Stop the active controller, keeping the loads it last applied."""
+        if self.controller is not None:
+            self.controller.stop()
+            self.controller = None
+
+    def get_controller_status(self) -> Optional[Dict]:
+        """
+        Get the state of the active controller.
+
+        Returns:
+            Controller status dictionary, or None if no controller is active
+        """
+        if self.controller is None:
+            return None
+
+        return self.controller.status()
+
+    def start_victim(self, victim):
+        """
+        Start a latency-measuring victim workload next to the load.
+
+        Any previously running victim is stopped first.
+
+        Args:
+            victim: Victim instance (see cpu_loader.victim)
+        """
+        self.stop_victim()
+        victim.start()
+        self.victim = victim
+
+    def stop_victim(self):
+        """Stop the running victim workload."""
+        if self.victim is not None:
+            self.victim.stop()
+            self.victim = None
+
+    def get_victim_status(self) -> Optional[Dict]:
+        """
+        Get the state and latency summary of the victim workload.
+
+        Returns:
+            Victim status dictionary, or None if no victim is running
+        """
+        if self.victim is None:
+            return None
+
+        return self.victim.status()
+
     def shutdown(self):
         """Shutdown all threads."""
+        self.stop_victim()
+        self.stop_controller()
         cpu_loader_core.shutdown()
@@ -0,0 +1,326 @@
+// Native benchmark of the load generation engine, without Python.
+// Measures timer overhead, kernel batch throughput, the cost of a load
+// update and how accurately workers hold their duty cycle, so engine
+// regressions can be told apart from interpreter noise.
+//
+// Build with 'python setup.py build_bench'.
+#define _GNU_SOURCE
+#include "cpu_loader_engine.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TIMER_CALLS 1000000
+#define CONTROL_UPDATES 200000
+
+static const char *kernel_names[] = {
+    "busy-wait", "pi", "primes", "matrix", "fibonacci", "stream", "cache"
+};
+
+static bool json_output = false;
+static bool first_result = true;
+
+// Print one result as a table row or a JSON object
+static void report(const char *group, const char *name, double value, const char *unit) {
+    if (json_output) {
+        printf("%s    {\"group\": \"%s\", \"name\": \"%s\", \"value\": %.6g, \"unit\": \"%s\"}",
+               first_result ? "" : ",\n", group, name, value, unit);
+    } else {
+        printf("%-10s %-28s %14.6g  %s\n", group, name, value, unit);
+    }
+    first_result = false;
+}
+
+// Mean nanoseconds per call of the clocks the worker loop reads
+static void bench_timers(void) {
+    long long start = get_time_ns();
+    for (int i = 0; i < TIMER_CALLS; i++) {
+        get_time_ns();
+    }
+    report("timer", "clock_monotonic", (double)(get_time_ns() - start) / TIMER_CALLS,
+           "ns/call");
+
+    start = get_time_ns();
+    for (int i = 0; i < TIMER_CALLS; i++) {
+        get_thread_cpu_time_ns();
+    }
+    report("timer", "thread_cputime", (double)(get_time_ns() - start) / TIMER_CALLS,
+           "ns/call");
+
+    int counter = open_cycle_counter();
+    start = get_time_ns();
+    for (int i = 0; i < TIMER_CALLS; i++) {
+        read_cpu_cycles(counter);
+    }
+    report("timer", counter >= 0 ? "cycle_counter" : "cycle_counter_estimate",
+           (double)(get_time_ns() - start) / TIMER_CALLS, "ns/call");
+    if (counter >= 0) {
+        close(counter);
+    }
+
+    // Oversleep of an absolute sleep, what every cycle ends with
+    long long total_late = 0;
+    for (int i = 0; i < 100; i++) {
+        long long deadline = get_time_ns() + 1000000LL;
+        sleep_until_ns(deadline);
+        total_late += get_time_ns() - deadline;
+    }
+    report("timer", "sleep_wakeup_late", total_late / 100.0 / 1e3, "us");
+}
+
+// Ops per second, batch duration and, with a hardware cycle counter, the
+// effective clock of every kernel on the calling thread
+static void bench_kernels(double seconds) {
+    int counter = open_cycle_counter();
+    double busy_wait_mhz = 0.0;
+
+    for (int type = 0; type <= COMPUTE_TYPE_LAST; type++) {
+        KernelState state;
+        init_kernel_state(&state);
+        if (type == COMPUTE_MEMORY_STREAM) {
+            prefault_stream_buffer(&state);
+        }
+
+        long long ops = 0;
+        long long batches = 0;
+        long long duration_ns = (long long)(seconds * 1e9);
+        long long start_cycles = read_cpu_cycles(counter);
+        long long start_user = get_thread_user_time_ns();
+        long long start = get_time_ns();
+        long long elapsed;
+        do {
+            if (type == COMPUTE_CACHE_POLLUTE) {
+                ops += cache_sweep(&state, CACHE_DEFAULT_FOOTPRINT);
+            } else {
+                ops += run_kernel_batch((ComputationType)type, &state);
+            }
+            batches++;
+            elapsed = get_time_ns() - start;
+        } while (elapsed < duration_ns);
+        long long cycles = read_cpu_cycles(counter) - start_cycles;
+        long long user_ns = get_thread_user_time_ns() - start_user;
+        free_kernel_state(&state);
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s_ops", kernel_names[type]);
+        report("kernel", name, ops * 1e9 / elapsed, "ops/s");
+        snprintf(name, sizeof(name), "%s_batch", kernel_names[type]);
+        report("kernel", name, (double)elapsed / batches, "ns");
+
+        // Without a counter the cycles are estimated from CPU time, which
+        // says nothing about the clock. The counter only counts user-space
+        // cycles, so they are divided by user CPU time.
+        if (counter >= 0 && user_ns > 0) {
+            double mhz = cycles * 1e3 / user_ns;
+            if (type == COMPUTE_BUSY_WAIT) {
+                busy_wait_mhz = mhz;
+            }
+            snprintf(name, sizeof(name), "%s_clock", kernel_names[type]);
+            report("kernel", name, mhz, "MHz");
+            if (busy_wait_mhz > 0.0) {
+                snprintf(name, sizeof(name), "%s_clock_ratio", kernel_names[type]);
+                report("kernel", name, mhz / busy_wait_mhz, "x busy-wait");
+            }
+        }
+    }
+
+    if (counter >= 0) {
+        close(counter);
+    }
+}
+
+// Cost of a load update as the Python binding makes it, while the worker
+// it targets is running
+static void bench_control(void) {
+    pthread_mutex_lock(&global_lock);
+    if (start_workers(1) != 0) {
+        pthread_mutex_unlock(&global_lock);
+        fprintf(stderr, "Failed to create thread\n");
+        exit(1);
+    }
+    set_worker_load(&workers[0], 0.5);
+    pthread_mutex_unlock(&global_lock);
+
+    long long start = get_time_ns();
+    for (int i = 0; i < CONTROL_UPDATES; i++) {
+        pthread_mutex_lock(&global_lock);
+        set_worker_load(&workers[0], (i & 1) ? 0.3 : 0.7);
+        pthread_mutex_unlock(&global_lock);
+    }
+    report("control", "set_load", (double)(get_time_ns() - start) / CONTROL_UPDATES,
+           "ns/update");
+
+    // Time until the worker runs with a new load, at random cycle phases
+    long long total_apply = 0;
+    int samples = 50;
+    for (int i = 0; i < samples; i++) {
+        struct timespec pause = {0, 3000000L + (rand() % 7) * 1000000L};
+        nanosleep(&pause, NULL);
+
+        pthread_mutex_lock(&global_lock);
+        long long issued = get_time_ns();
+        set_worker_load(&workers[0], (i & 1) ? 0.3 : 0.7);
+        pthread_mutex_lock(&workers[0].lock);
+        unsigned long long seq = workers[0].load_seq;
+        pthread_mutex_unlock(&workers[0].lock);
+        pthread_mutex_unlock(&global_lock);
+
+        for (;;) {
+            pthread_mutex_lock(&workers[0].lock);
+            bool applied = workers[0].applied_seq >= seq;
+            long long applied_ns = workers[0].applied_ns;
+            pthread_mutex_unlock(&workers[0].lock);
+            if (applied) {
+                total_apply += applied_ns - issued;
+                break;
+            }
+            struct timespec poll = {0, 50000};
+            nanosleep(&poll, NULL);
+        }
+    }
+    report("control", "apply_latency", total_apply / (double)samples / 1e3, "us");
+
+    pthread_mutex_lock(&global_lock);
+    stop_workers();
+    pthread_mutex_unlock(&global_lock);
+}
+
+// Achieved versus requested duty cycle and cycle duration jitter
+static void bench_cycles(int threads, double seconds) {
+    static const double loads[] = {0.25, 0.5, 0.75};
+
+    pthread_mutex_lock(&global_lock);
+    if (start_workers(threads) != 0) {
+        pthread_mutex_unlock(&global_lock);
+        fprintf(stderr, "Failed to create thread\n");
+        exit(1);
+    }
+    pthread_mutex_unlock(&global_lock);
+
+    for (size_t l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+        pthread_mutex_lock(&global_lock);
+        for (int i = 0; i < num_threads; i++) {
+            set_worker_load(&workers[i], loads[l]);
+        }
+        pthread_mutex_unlock(&global_lock);
+
+        // Let the new load take effect before measuring
+        struct timespec settle = {0, 200000000L};
+        nanosleep(&settle, NULL);
+
+        long long before_cpu = 0, before_cycles = 0, before_jitter = 0;
+        for (int i = 0; i < num_threads; i++) {
+            pthread_mutex_lock(&workers[i].lock);
+            before_cpu += workers[i].cpu_time_ns;
+            before_cycles += workers[i].cycles;
+            before_jitter += (long long)workers[i].jitter_sum_ns;
+            pthread_mutex_unlock(&workers[i].lock);
+        }
+        long long start = get_time_ns();
+
+        struct timespec run = {(time_t)seconds,
+                               (long)((seconds - (time_t)seconds) * 1e9)};
+        nanosleep(&run, NULL);
+
+        long long elapsed = get_time_ns() - start;
+        long long cpu = 0, cycles = 0, jitter = 0;
+        for (int i = 0; i < num_threads; i++) {
+            pthread_mutex_lock(&workers[i].lock);
+            cpu += workers[i].cpu_time_ns;
+            cycles += workers[i].cycles;
+            jitter += (long long)workers[i].jitter_sum_ns;
+            pthread_mutex_unlock(&workers[i].lock);
+        }
+        cpu -= before_cpu;
+        cycles -= before_cycles;
+        jitter -= before_jitter;
+
+        char name[64];
+        double achieved = (double)cpu / elapsed / num_threads;
+        snprintf(name, sizeof(name), "load_%d_error", (int)(loads[l] * 100));
+        report("cycle", name, (achieved - loads[l]) * 100.0, "points");
+        snprintf(name, sizeof(name), "load_%d_jitter", (int)(loads[l] * 100));
+        report("cycle", name, cycles ? jitter / (double)cycles / 1e3 : 0.0, "us");
+        snprintf(name, sizeof(name), "load_%d_cycle_rate", (int)(loads[l] * 100));
+        report("cycle", name,
+               (double)cycles * cycle_time_ns / elapsed / num_threads * 100.0,
+               "% of nominal");
+    }
+
+    pthread_mutex_lock(&global_lock);
+    stop_workers();
+    pthread_mutex_unlock(&global_lock);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-d SECONDS] [-t THREADS] [-c CYCLE_MS] [-j]\n"
+            "  -d, --duration   seconds per kernel and load level (default: 1)\n"
+            "  -t, --threads    worker threads for the cycle test (default: 1)\n"
+            "  -c, --cycle-ms   duty cycle period in ms (default: 10)\n"
+            "  -j, --json       print results as JSON\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    static const struct option options[] = {
+        {"duration", required_argument, NULL, 'd'},
+        {"threads", required_argument, NULL, 't'},
+        {"cycle-ms", required_argument, NULL, 'c'},
+        {"json", no_argument, NULL, 'j'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    double seconds = 1.0;
+    int threads = 1;
+    double cycle_ms = DEFAULT_CYCLE_TIME_NS / 1e6;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "d:t:c:jh", options, NULL)) != -1) {
+        switch (opt) {
+            case 'd':
+                seconds = atof(optarg);
+                break;
+            case 't':
+                threads = atoi(optarg);
+                break;
+            case 'c':
+                cycle_ms = atof(optarg);
+                break;
+            case 'j':
+                json_output = true;
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    long long cycle_ns = (long long)(cycle_ms * 1e6);
+    if (seconds <= 0.0 || threads <= 0 || cycle_ns < MIN_CYCLE_TIME_NS ||
+        cycle_ns > MAX_CYCLE_TIME_NS) {
+        usage(argv[0]);
+        return 2;
+    }
+    cycle_time_ns = cycle_ns;
+
+    if (json_output) {
+        printf("{\n  \"duration_s\": %g,\n  \"threads\": %d,\n  \"cycle_ms\": %g,\n"
+               "  \"results\": [\n", seconds, threads, cycle_ms);
+    } else {
+        printf("%-10s %-28s %14s  %s\n", "group", "name", "value", "unit");
+    }
+
+    bench_timers();
+    bench_kernels(seconds);
+    bench_control();
+    bench_cycles(threads, seconds);
+
+    if (json_output) {
+        printf("\n  ]\n}\n");
+    }
+    return 0;
+}
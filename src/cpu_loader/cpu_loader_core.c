@@ -5,260 +5,152 @@
 #include <unistd.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
 
-#define CYCLE_TIME_NS 10000000L  // 10ms in nanoseconds for better responsiveness
+#include "cpu_loader_engine.h"
 
-// Computation types for busy-wait
-typedef enum {
-    COMPUTE_BUSY_WAIT = 0,
-    COMPUTE_PI_CALCULATION = 1,
-    COMPUTE_PRIME_NUMBERS = 2,
-    COMPUTE_MATRIX_MULTIPLY = 3,
-    COMPUTE_FIBONACCI = 4
-} ComputationType;
-
-typedef struct {
-    pthread_t thread;
-    int thread_id;
-    double load;  // 0.0 to 1.0
-    bool running;
-    bool stop;
-    ComputationType compute_type;
-    pthread_mutex_t lock;
-} WorkerThread;
-
-static WorkerThread *workers = NULL;
-static int num_threads = 0;
-static ComputationType global_compute_type = COMPUTE_BUSY_WAIT;
-static pthread_mutex_t global_lock = PTHREAD_MUTEX_INITIALIZER;
-
-// High-resolution timer
-static inline long long get_time_ns(void) {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
-}
+// Initialize the CPU loader with specified number of threads
+static PyObject *init_loader(PyObject *self, PyObject *args) {
+    int new_num_threads;
 
-// Time-controlled PI calculation using Leibniz formula
-static void calculate_pi_timed(long long duration_ns) {
-    long long start = get_time_ns();
-    double pi = 0.0;
-    int i = 0;
-
-    // Check time every 100 iterations for better responsiveness
-    while ((get_time_ns() - start) < duration_ns) {
-        for (int batch = 0; batch < 100 && (get_time_ns() - start) < duration_ns; batch++) {
-            pi += (i % 2 == 0 ? 1.0 : -1.0) / (2 * i + 1);
-            i++;
-        }
+    if (!PyArg_ParseTuple(args, "i", &new_num_threads)) {
+        return NULL;
     }
-}
-
-// Prime number checking (time-controlled)
-static bool is_prime_quick(long long n) {
-    if (n < 2) return false;
-    if (n == 2) return true;
-    if (n % 2 == 0) return false;
 
-    for (long long i = 3; i * i <= n; i += 2) {
-        if (n % i == 0) return false;
+    if (new_num_threads <= 0) {
+        PyErr_SetString(PyExc_ValueError, "Number of threads must be positive");
+        return NULL;
     }
-    return true;
-}
 
-// Time-controlled prime number finding
-static void find_primes_timed(long long duration_ns) {
-    long long start = get_time_ns();
-    long long n = 1000; // Start from a reasonable number
+    pthread_mutex_lock(&global_lock);
 
-    while ((get_time_ns() - start) < duration_ns) {
-        // Process numbers one by one with frequent time checks
-        is_prime_quick(n);
-        n++;
-        if (n > 100000) n = 1000; // Reset to avoid overflow
+    // Stop existing threads if any
+    stop_workers();
 
-        // Check time more frequently for better control
-        if ((n % 50) == 0 && (get_time_ns() - start) >= duration_ns) {
-            break;
-        }
+    if (start_workers(new_num_threads) != 0) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_RuntimeError, "Failed to create thread");
+        return NULL;
     }
-}
 
-// Simple matrix multiplication (4x4 matrices) - time controlled
-static void matrix_multiply_timed(long long duration_ns) {
-    long long start = get_time_ns();
-    double a[4][4] = {{1,2,3,4},{5,6,7,8},{9,10,11,12},{13,14,15,16}};
-    double b[4][4] = {{16,15,14,13},{12,11,10,9},{8,7,6,5},{4,3,2,1}};
-    double result[4][4];
-
-    while ((get_time_ns() - start) < duration_ns) {
-        // Perform matrix multiplication with frequent time checks
-        for (int i = 0; i < 4; i++) {
-            for (int j = 0; j < 4; j++) {
-                result[i][j] = 0;
-                for (int k = 0; k < 4; k++) {
-                    result[i][j] += a[i][k] * b[k][j];
-                }
-                // Check time after each element calculation
-                if ((get_time_ns() - start) >= duration_ns) {
-                    return;
-                }
-            }
-        }
-        // Vary matrices slightly to prevent optimization
-        a[0][0] = result[0][0] / 1000000.0;
-    }
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
 }
 
-// Time-controlled lightweight computational work (simplified approach)
-static void fibonacci_timed(long long duration_ns) {
-    long long start = get_time_ns();
-    volatile double result = 0.0; // Use volatile to prevent optimization
-    int counter = 0;
-
-    while ((get_time_ns() - start) < duration_ns) {
-        // Perform lightweight mathematical operations
-        for (int i = 0; i < 100 && (get_time_ns() - start) < duration_ns; i++) {
-            result += counter * 1.1 + 0.5;
-            counter = (counter + 1) % 1000;
-        }
+// Replace all workers with named groups of consecutive threads.
+// Takes a sequence of (name, thread_count) pairs.
+static PyObject *define_groups(PyObject *self, PyObject *args) {
+    PyObject *spec;
 
-        // Small computational pause
-        struct timespec tiny_pause = {0, 5000}; // 5 microseconds
-        nanosleep(&tiny_pause, NULL);
+    if (!PyArg_ParseTuple(args, "O", &spec)) {
+        return NULL;
     }
-}
 
-// Perform computation based on type for specified duration
-static void perform_computation(ComputationType type, long long duration_ns) {
-    switch (type) {
-        case COMPUTE_PI_CALCULATION:
-            calculate_pi_timed(duration_ns);
-            break;
-
-        case COMPUTE_PRIME_NUMBERS:
-            find_primes_timed(duration_ns);
-            break;
-
-        case COMPUTE_MATRIX_MULTIPLY:
-            matrix_multiply_timed(duration_ns);
-            break;
-
-        case COMPUTE_FIBONACCI:
-            fibonacci_timed(duration_ns);
-            break;
-
-        case COMPUTE_BUSY_WAIT:
-        default:
-            // Original busy-wait implementation
-            {
-                long long start = get_time_ns();
-                while ((get_time_ns() - start) < duration_ns) {
-                    // Busy loop
-                }
-            }
-            break;
+    PyObject *seq = PySequence_Fast(spec, "Groups must be a sequence of (name, count) pairs");
+    if (seq == NULL) {
+        return NULL;
     }
-}
-
-// Busy-wait for specified nanoseconds (backward compatibility)
-static inline void busy_wait_ns(long long ns) {
-    perform_computation(COMPUTE_BUSY_WAIT, ns);
-}
 
-static void *worker_thread(void *arg) {
-    WorkerThread *worker = (WorkerThread *)arg;
-
-    while (!worker->stop) {
-        long long cycle_start = get_time_ns();
-
-        pthread_mutex_lock(&worker->lock);
-        double load = worker->load;
-        ComputationType compute_type = worker->compute_type;
-        pthread_mutex_unlock(&worker->lock);
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    if (n <= 0) {
+        Py_DECREF(seq);
+        PyErr_SetString(PyExc_ValueError, "At least one group is required");
+        return NULL;
+    }
 
-        if (load <= 0.0) {
-            // No load, sleep for the full cycle
-            struct timespec sleep_time = {0, CYCLE_TIME_NS};
-            nanosleep(&sleep_time, NULL);
-        } else if (load >= 1.0) {
-            // 100% load, perform computation for the entire cycle
-            perform_computation(compute_type, CYCLE_TIME_NS);
-        } else {
-            // Partial load
-            long long work_time_ns = (long long)(load * CYCLE_TIME_NS);
-
-            // Perform computation for work time
-            perform_computation(compute_type, work_time_ns);
-
-            // Sleep for the rest of the cycle
-            long long elapsed = get_time_ns() - cycle_start;
-            long long remaining = CYCLE_TIME_NS - elapsed;
-
-            if (remaining > 1000000) {  // > 1ms
-                // Sleep for most of the remaining time
-                struct timespec sleep_time;
-                sleep_time.tv_sec = remaining / 1000000000L;
-                sleep_time.tv_nsec = remaining % 1000000000L;
-                nanosleep(&sleep_time, NULL);
+    WorkerGroup *new_groups = calloc(n, sizeof(WorkerGroup));
+    if (new_groups == NULL) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    int total = 0;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        const char *name;
+        int count;
+
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(seq, i), "si", &name, &count)) {
+            free(new_groups);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        if (count <= 0) {
+            free(new_groups);
+            Py_DECREF(seq);
+            PyErr_Format(PyExc_ValueError, "Group '%s' needs a positive thread count", name);
+            return NULL;
+        }
+        if (name[0] == '\0' || strlen(name) >= MAX_GROUP_NAME) {
+            free(new_groups);
+            Py_DECREF(seq);
+            PyErr_Format(PyExc_ValueError, "Group names must be 1 to %d characters",
+                         MAX_GROUP_NAME - 1);
+            return NULL;
+        }
+        for (Py_ssize_t j = 0; j < i; j++) {
+            if (strcmp(new_groups[j].name, name) == 0) {
+                free(new_groups);
+                Py_DECREF(seq);
+                PyErr_Format(PyExc_ValueError, "Duplicate group name '%s'", name);
+                return NULL;
             }
         }
-    }
 
-    return NULL;
-}
+        strcpy(new_groups[i].name, name);
+        new_groups[i].first_thread = total;
+        new_groups[i].count = count;
+        total += count;
+    }
+    Py_DECREF(seq);
 
-// Initialize the CPU loader with specified number of threads
-static PyObject *init_loader(PyObject *self, PyObject *args) {
-    int new_num_threads;
+    pthread_mutex_lock(&global_lock);
 
-    if (!PyArg_ParseTuple(args, "i", &new_num_threads)) {
-        return NULL;
-    }
+    stop_workers();
 
-    if (new_num_threads <= 0) {
-        PyErr_SetString(PyExc_ValueError, "Number of threads must be positive");
+    if (start_workers(total) != 0) {
+        pthread_mutex_unlock(&global_lock);
+        free(new_groups);
+        PyErr_SetString(PyExc_RuntimeError, "Failed to create thread");
         return NULL;
     }
 
-    pthread_mutex_lock(&global_lock);
-
-    // Stop existing threads if any
-    if (workers != NULL) {
-        for (int i = 0; i < num_threads; i++) {
-            workers[i].stop = true;
+    groups = new_groups;
+    num_groups = (int)n;
+    for (int g = 0; g < num_groups; g++) {
+        for (int i = 0; i < groups[g].count; i++) {
+            workers[groups[g].first_thread + i].group_id = g;
         }
-        for (int i = 0; i < num_threads; i++) {
-            pthread_join(workers[i].thread, NULL);
-            pthread_mutex_destroy(&workers[i].lock);
-        }
-        free(workers);
     }
 
-    // Allocate new workers
-    num_threads = new_num_threads;
-    workers = calloc(num_threads, sizeof(WorkerThread));
+    pthread_mutex_unlock(&global_lock);
 
-    // Start threads
-    for (int i = 0; i < num_threads; i++) {
-        workers[i].thread_id = i;
-        workers[i].load = 0.0;
-        workers[i].running = false;
-        workers[i].stop = false;
-        workers[i].compute_type = global_compute_type;
-        pthread_mutex_init(&workers[i].lock, NULL);
+    Py_RETURN_NONE;
+}
 
-        if (pthread_create(&workers[i].thread, NULL, worker_thread, &workers[i]) != 0) {
-            pthread_mutex_unlock(&global_lock);
-            PyErr_SetString(PyExc_RuntimeError, "Failed to create thread");
-            return NULL;
+// Get groups as a dict mapping group name to its list of thread IDs
+static PyObject *get_groups(PyObject *self, PyObject *args) {
+    pthread_mutex_lock(&global_lock);
+
+    PyObject *dict = PyDict_New();
+    for (int g = 0; g < num_groups; g++) {
+        PyObject *ids = PyList_New(groups[g].count);
+        for (int i = 0; i < groups[g].count; i++) {
+            PyList_SET_ITEM(ids, i, PyLong_FromLong(groups[g].first_thread + i));
         }
-        workers[i].running = true;
+        PyDict_SetItemString(dict, groups[g].name, ids);
+        Py_DECREF(ids);
     }
 
     pthread_mutex_unlock(&global_lock);
 
-    Py_RETURN_NONE;
+    return dict;
 }
 
 // Set load for a specific thread
@@ -284,9 +176,7 @@ static PyObject *set_thread_load(PyObject *self, PyObject *args) {
         return NULL;
     }
 
-    pthread_mutex_lock(&workers[thread_id].lock);
-    workers[thread_id].load = load_percent / 100.0;
-    pthread_mutex_unlock(&workers[thread_id].lock);
+    set_worker_load(&workers[thread_id], load_percent / 100.0);
 
     pthread_mutex_unlock(&global_lock);
 
@@ -340,6 +230,254 @@ static PyObject *get_all_loads(PyObject *self, PyObject *args) {
     return dict;
 }
 
+// Distribute a total budget of cores across all threads. Packed puts as
+// many threads as possible at 100% and the remainder on the next one,
+// spread gives every thread the same share.
+static PyObject *set_core_budget(PyObject *self, PyObject *args) {
+    double cores;
+    int spread;
+
+    if (!PyArg_ParseTuple(args, "dp", &cores, &spread)) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+
+    if (cores < 0.0 || cores > num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_Format(PyExc_ValueError, "Core budget must be between 0 and %d", num_threads);
+        return NULL;
+    }
+
+    double remaining = cores;
+    for (int i = 0; i < num_threads; i++) {
+        double load;
+        if (spread) {
+            load = cores / num_threads;
+        } else {
+            load = remaining > 1.0 ? 1.0 : remaining;
+            remaining -= load;
+        }
+
+        set_worker_load(&workers[i], load);
+    }
+
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Set a throughput target (ops per second) for a specific thread
+static PyObject *set_thread_ops_target(PyObject *self, PyObject *args) {
+    int thread_id;
+    double ops_per_sec;
+
+    if (!PyArg_ParseTuple(args, "id", &thread_id, &ops_per_sec)) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+
+    if (thread_id < 0 || thread_id >= num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Invalid thread ID");
+        return NULL;
+    }
+
+    if (ops_per_sec < 0.0) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Ops target must not be negative");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&workers[thread_id].lock);
+    workers[thread_id].target_ops = ops_per_sec;
+    workers[thread_id].target_cpu_cycles = 0.0;
+    workers[thread_id].load_seq++;
+    pthread_mutex_unlock(&workers[thread_id].lock);
+
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Set a core cycles per second target for a specific thread (0 = duty-cycle mode)
+static PyObject *set_thread_cycles_target(PyObject *self, PyObject *args) {
+    int thread_id;
+    double cycles_per_sec;
+
+    if (!PyArg_ParseTuple(args, "id", &thread_id, &cycles_per_sec)) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+
+    if (thread_id < 0 || thread_id >= num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Invalid thread ID");
+        return NULL;
+    }
+
+    if (cycles_per_sec < 0.0) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Cycles target must not be negative");
+        return NULL;
+    }
+
+    if (cycles_per_sec > 0.0 && reference_hz <= 0.0 && !cycle_counter_available()) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError,
+                        "No cycle counter and no reference frequency to count cycles");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&workers[thread_id].lock);
+    workers[thread_id].target_cpu_cycles = cycles_per_sec;
+    workers[thread_id].target_ops = 0.0;
+    workers[thread_id].load_seq++;
+    pthread_mutex_unlock(&workers[thread_id].lock);
+
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Set the nominal frequency used to estimate cycles without a counter
+static PyObject *set_reference_frequency(PyObject *self, PyObject *args) {
+    double hz;
+
+    if (!PyArg_ParseTuple(args, "d", &hz)) {
+        return NULL;
+    }
+
+    if (hz <= 0.0) {
+        PyErr_SetString(PyExc_ValueError, "Reference frequency must be positive");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+    reference_hz = hz;
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Get the nominal frequency used to estimate cycles, 0.0 if not set
+static PyObject *get_reference_frequency(PyObject *self, PyObject *args) {
+    pthread_mutex_lock(&global_lock);
+    double hz = reference_hz;
+    pthread_mutex_unlock(&global_lock);
+
+    return PyFloat_FromDouble(hz);
+}
+
+// Whether threads can count core cycles with a hardware counter
+static PyObject *has_cycle_counter(PyObject *self, PyObject *args) {
+    return PyBool_FromLong(cycle_counter_available());
+}
+
+// Build the statistics dict for a worker (caller holds the worker lock)
+static PyObject *build_worker_stats(const WorkerThread *worker) {
+    PyObject *jitter_hist = PyTuple_New(JITTER_BUCKETS);
+    if (jitter_hist == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < JITTER_BUCKETS; i++) {
+        PyObject *count = PyLong_FromUnsignedLongLong(worker->jitter_hist[i]);
+        if (count == NULL) {
+            Py_DECREF(jitter_hist);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(jitter_hist, i, count);
+    }
+
+    return Py_BuildValue(
+        "{s:K,s:L,s:L,s:L,s:L,s:d,s:d,s:d,s:i,s:n,s:K,s:d,s:d,s:O,s:K,s:K,s:L,s:l,s:L,"
+        "s:N,s:K,s:L}",
+        "ops", worker->total_ops,
+        "busy_ns", worker->busy_ns,
+        "cycles", worker->cycles,
+        "cpu_time_ns", worker->cpu_time_ns,
+        "user_time_ns", worker->user_time_ns,
+        "achieved_load", worker->achieved_load * 100.0,
+        "ops_per_sec", worker->ops_rate,
+        "target_ops_per_sec", worker->target_ops,
+        "computation_type", (int)worker->compute_type,
+        "cache_footprint", (Py_ssize_t)worker->cache_footprint,
+        "cpu_cycles", worker->cpu_cycles,
+        "cpu_cycles_per_sec", worker->cpu_cycles_rate,
+        "target_cpu_cycles_per_sec", worker->target_cpu_cycles,
+        "cycles_counted", worker->cycles_counted ? Py_True : Py_False,
+        "load_seq", worker->load_seq,
+        "applied_seq", worker->applied_seq,
+        "applied_ns", worker->applied_ns,
+        "tid", worker->tid,
+        "cycle_ns", worker->cycle_ns,
+        "cycle_jitter_hist", jitter_hist,
+        "cycle_jitter_sum_ns", worker->jitter_sum_ns,
+        "cycle_jitter_max_ns", worker->jitter_max_ns);
+}
+
+// Get statistics for a specific thread
+static PyObject *get_thread_stats(PyObject *self, PyObject *args) {
+    int thread_id;
+
+    if (!PyArg_ParseTuple(args, "i", &thread_id)) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+
+    if (thread_id < 0 || thread_id >= num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Invalid thread ID");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&workers[thread_id].lock);
+    PyObject *stats = build_worker_stats(&workers[thread_id]);
+    pthread_mutex_unlock(&workers[thread_id].lock);
+
+    pthread_mutex_unlock(&global_lock);
+
+    return stats;
+}
+
+// Get statistics for all threads
+static PyObject *get_all_stats(PyObject *self, PyObject *args) {
+    pthread_mutex_lock(&global_lock);
+
+    PyObject *dict = PyDict_New();
+    if (dict == NULL) {
+        pthread_mutex_unlock(&global_lock);
+        return NULL;
+    }
+    for (int i = 0; i < num_threads; i++) {
+        pthread_mutex_lock(&workers[i].lock);
+        PyObject *value = build_worker_stats(&workers[i]);
+        pthread_mutex_unlock(&workers[i].lock);
+        if (value == NULL) {
+            pthread_mutex_unlock(&global_lock);
+            Py_DECREF(dict);
+            return NULL;
+        }
+
+        PyObject *key = PyLong_FromLong(i);
+        int rc = key != NULL ? PyDict_SetItem(dict, key, value) : -1;
+        Py_XDECREF(key);
+        Py_DECREF(value);
+        if (rc != 0) {
+            pthread_mutex_unlock(&global_lock);
+            Py_DECREF(dict);
+            return NULL;
+        }
+    }
+
+    pthread_mutex_unlock(&global_lock);
+
+    return dict;
+}
+
 // Get number of threads
 static PyObject *get_num_threads(PyObject *self, PyObject *args) {
     pthread_mutex_lock(&global_lock);
@@ -357,7 +495,7 @@ static PyObject *set_computation_type(PyObject *self, PyObject *args) {
         return NULL;
     }
 
-    if (comp_type < 0 || comp_type > COMPUTE_FIBONACCI) {
+    if (comp_type < 0 || comp_type > COMPUTE_TYPE_LAST) {
         PyErr_SetString(PyExc_ValueError, "Invalid computation type");
         return NULL;
     }
@@ -386,23 +524,340 @@ static PyObject *get_computation_type(PyObject *self, PyObject *args) {
     return PyLong_FromLong(comp_type);
 }
 
-// Shutdown all threads
-static PyObject *shutdown_loader(PyObject *self, PyObject *args) {
+// Enable or disable phase-staggered cycle starts
+static PyObject *set_phase_stagger(PyObject *self, PyObject *args) {
+    int enabled;
+
+    if (!PyArg_ParseTuple(args, "p", &enabled)) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+    global_phase_stagger = enabled;
+
+    // Update all existing workers
+    for (int i = 0; i < num_threads; i++) {
+        pthread_mutex_lock(&workers[i].lock);
+        workers[i].stagger = global_phase_stagger;
+        pthread_mutex_unlock(&workers[i].lock);
+    }
+
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Get phase stagger setting
+static PyObject *get_phase_stagger(PyObject *self, PyObject *args) {
+    pthread_mutex_lock(&global_lock);
+    bool enabled = global_phase_stagger;
+    pthread_mutex_unlock(&global_lock);
+
+    return PyBool_FromLong(enabled);
+}
+
+// Set the duty cycle period of all workers
+static PyObject *set_cycle_time(PyObject *self, PyObject *args) {
+    long long new_cycle_ns;
+
+    if (!PyArg_ParseTuple(args, "L", &new_cycle_ns)) {
+        return NULL;
+    }
+
+    if (new_cycle_ns < MIN_CYCLE_TIME_NS || new_cycle_ns > MAX_CYCLE_TIME_NS) {
+        PyErr_Format(PyExc_ValueError, "Cycle time must be between %ld and %ld ms",
+                     MIN_CYCLE_TIME_NS / 1000000L, MAX_CYCLE_TIME_NS / 1000000L);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+    cycle_time_ns = new_cycle_ns;
+
+    // Update all existing workers, they switch with their next cycle
+    for (int i = 0; i < num_threads; i++) {
+        pthread_mutex_lock(&workers[i].lock);
+        workers[i].cycle_ns = cycle_time_ns;
+        pthread_mutex_unlock(&workers[i].lock);
+    }
+
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Get the duty cycle period in nanoseconds
+static PyObject *get_cycle_time(PyObject *self, PyObject *args) {
+    pthread_mutex_lock(&global_lock);
+    long long cycle_ns = cycle_time_ns;
+    pthread_mutex_unlock(&global_lock);
+
+    return PyLong_FromLongLong(cycle_ns);
+}
+
+// Set computation type for a specific thread
+static PyObject *set_thread_computation_type(PyObject *self, PyObject *args) {
+    int thread_id;
+    int comp_type;
+
+    if (!PyArg_ParseTuple(args, "ii", &thread_id, &comp_type)) {
+        return NULL;
+    }
+
+    if (comp_type < 0 || comp_type > COMPUTE_TYPE_LAST) {
+        PyErr_SetString(PyExc_ValueError, "Invalid computation type");
+        return NULL;
+    }
+
     pthread_mutex_lock(&global_lock);
 
-    if (workers != NULL) {
-        for (int i = 0; i < num_threads; i++) {
-            workers[i].stop = true;
+    if (thread_id < 0 || thread_id >= num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Invalid thread ID");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&workers[thread_id].lock);
+    workers[thread_id].compute_type = (ComputationType)comp_type;
+    pthread_mutex_unlock(&workers[thread_id].lock);
+
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Pin a specific thread to a set of CPUs (empty sequence = all CPUs)
+static PyObject *set_thread_affinity(PyObject *self, PyObject *args) {
+#ifdef __linux__
+    int thread_id;
+    PyObject *cpus;
+
+    if (!PyArg_ParseTuple(args, "iO", &thread_id, &cpus)) {
+        return NULL;
+    }
+
+    PyObject *seq = PySequence_Fast(cpus, "CPUs must be a sequence of integers");
+    if (seq == NULL) {
+        return NULL;
+    }
+
+    long num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        long cpu = PyLong_AsLong(PySequence_Fast_GET_ITEM(seq, i));
+        if (cpu == -1 && PyErr_Occurred()) {
+            Py_DECREF(seq);
+            return NULL;
         }
-        for (int i = 0; i < num_threads; i++) {
-            pthread_join(workers[i].thread, NULL);
-            pthread_mutex_destroy(&workers[i].lock);
+        if (cpu < 0 || cpu >= num_cpus || cpu >= CPU_SETSIZE) {
+            Py_DECREF(seq);
+            PyErr_Format(PyExc_ValueError, "CPU %ld does not exist", cpu);
+            return NULL;
+        }
+        CPU_SET(cpu, &set);
+    }
+    Py_DECREF(seq);
+
+    if (n == 0) {
+        for (long cpu = 0; cpu < num_cpus && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, &set);
         }
-        free(workers);
-        workers = NULL;
-        num_threads = 0;
     }
 
+    pthread_mutex_lock(&global_lock);
+
+    if (thread_id < 0 || thread_id >= num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Invalid thread ID");
+        return NULL;
+    }
+
+    int err = pthread_setaffinity_np(workers[thread_id].thread, sizeof(set), &set);
+
+    pthread_mutex_unlock(&global_lock);
+
+    if (err != 0) {
+        errno = err;
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+
+    Py_RETURN_NONE;
+#else
+    PyErr_SetString(PyExc_NotImplementedError, "Thread affinity is only supported on Linux");
+    return NULL;
+#endif
+}
+
+// Set the nice value of a specific thread
+static PyObject *set_thread_priority(PyObject *self, PyObject *args) {
+#ifdef __linux__
+    int thread_id;
+    int nice_value;
+
+    if (!PyArg_ParseTuple(args, "ii", &thread_id, &nice_value)) {
+        return NULL;
+    }
+
+    if (nice_value < -20 || nice_value > 19) {
+        PyErr_SetString(PyExc_ValueError, "Nice value must be between -20 and 19");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+
+    if (thread_id < 0 || thread_id >= num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Invalid thread ID");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&workers[thread_id].lock);
+    long tid = workers[thread_id].tid;
+    pthread_mutex_unlock(&workers[thread_id].lock);
+
+    int rc = setpriority(PRIO_PROCESS, (id_t)tid, nice_value);
+
+    pthread_mutex_unlock(&global_lock);
+
+    if (rc != 0) {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+
+    Py_RETURN_NONE;
+#else
+    PyErr_SetString(PyExc_NotImplementedError, "Thread priority is only supported on Linux");
+    return NULL;
+#endif
+}
+
+// Set the load waveform of a specific thread
+static PyObject *set_thread_waveform(PyObject *self, PyObject *args) {
+    int thread_id;
+    int waveform;
+    double period_ms;
+    double amplitude_percent;
+
+    if (!PyArg_ParseTuple(args, "iidd", &thread_id, &waveform, &period_ms, &amplitude_percent)) {
+        return NULL;
+    }
+
+    if (waveform < WAVE_CONSTANT || waveform > WAVE_SAWTOOTH) {
+        PyErr_SetString(PyExc_ValueError, "Invalid waveform");
+        return NULL;
+    }
+
+    if (amplitude_percent < 0.0 || amplitude_percent > 100.0) {
+        PyErr_SetString(PyExc_ValueError, "Amplitude must be between 0 and 100");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+
+    if (thread_id < 0 || thread_id >= num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Invalid thread ID");
+        return NULL;
+    }
+
+    if (waveform != WAVE_CONSTANT && period_ms < cycle_time_ns / 1e6 * 2) {
+        long long min_period_ms = cycle_time_ns / 1000000LL * 2;
+        pthread_mutex_unlock(&global_lock);
+        PyErr_Format(PyExc_ValueError, "Waveform period must be at least %lld ms",
+                     min_period_ms);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&workers[thread_id].lock);
+    workers[thread_id].waveform = (WaveformType)waveform;
+    workers[thread_id].wave_period_ns = (long long)(period_ms * 1e6);
+    workers[thread_id].wave_amplitude = amplitude_percent / 100.0;
+    pthread_mutex_unlock(&workers[thread_id].lock);
+
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Prefault the kernel buffers of all workers and wait until they are done
+static PyObject *prefault_workers(PyObject *self, PyObject *args) {
+    // Prefaulting takes a while, so release the GIL. global_lock is taken
+    // and released inside so it is never held while waiting for the GIL.
+    Py_BEGIN_ALLOW_THREADS
+    pthread_mutex_lock(&global_lock);
+
+    for (int i = 0; i < num_threads; i++) {
+        pthread_mutex_lock(&workers[i].lock);
+        workers[i].prefault = true;
+        pthread_mutex_unlock(&workers[i].lock);
+    }
+
+    // Workers pick up the request at their next cycle
+    for (int i = 0; i < num_threads; i++) {
+        while (true) {
+            pthread_mutex_lock(&workers[i].lock);
+            bool pending = workers[i].prefault;
+            pthread_mutex_unlock(&workers[i].lock);
+            if (!pending) {
+                break;
+            }
+            struct timespec poll = {0, 1000000};
+            nanosleep(&poll, NULL);
+        }
+    }
+
+    pthread_mutex_unlock(&global_lock);
+    Py_END_ALLOW_THREADS
+
+    Py_RETURN_NONE;
+}
+
+// Set the number of bytes the cache kernel keeps dirty for a thread
+static PyObject *set_thread_cache_footprint(PyObject *self, PyObject *args) {
+    int thread_id;
+    Py_ssize_t footprint;
+
+    if (!PyArg_ParseTuple(args, "in", &thread_id, &footprint)) {
+        return NULL;
+    }
+
+    if (footprint < CACHE_LINE_BYTES) {
+        PyErr_Format(PyExc_ValueError, "Cache footprint must be at least %d bytes",
+                     CACHE_LINE_BYTES);
+        return NULL;
+    }
+
+    if (footprint > CACHE_MAX_FOOTPRINT) {
+        PyErr_Format(PyExc_ValueError, "Cache footprint must be at most %ld bytes",
+                     CACHE_MAX_FOOTPRINT);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&global_lock);
+
+    if (thread_id < 0 || thread_id >= num_threads) {
+        pthread_mutex_unlock(&global_lock);
+        PyErr_SetString(PyExc_ValueError, "Invalid thread ID");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&workers[thread_id].lock);
+    workers[thread_id].cache_footprint =
+        (size_t)footprint / CACHE_LINE_BYTES * CACHE_LINE_BYTES;
+    pthread_mutex_unlock(&workers[thread_id].lock);
+
+    pthread_mutex_unlock(&global_lock);
+
+    Py_RETURN_NONE;
+}
+
+// Shutdown all threads
+static PyObject *shutdown_loader(PyObject *self, PyObject *args) {
+    pthread_mutex_lock(&global_lock);
+
+    stop_workers();
+
     pthread_mutex_unlock(&global_lock);
 
     Py_RETURN_NONE;
@@ -414,9 +869,38 @@ static PyMethodDef CoreMethods[] = {
     {"set_thread_load", set_thread_load, METH_VARARGS, "Set load for a thread"},
     {"get_thread_load", get_thread_load, METH_VARARGS, "Get load for a thread"},
     {"get_all_loads", get_all_loads, METH_NOARGS, "Get all thread loads"},
+    {"set_core_budget", set_core_budget, METH_VARARGS, "Distribute a core budget across threads"},
+    {"set_thread_ops_target", set_thread_ops_target, METH_VARARGS, "Set ops/s target for a thread"},
+    {"set_thread_cycles_target", set_thread_cycles_target, METH_VARARGS,
+     "Set core cycles/s target for a thread"},
+    {"set_reference_frequency", set_reference_frequency, METH_VARARGS,
+     "Set the nominal frequency for cycle estimates"},
+    {"get_reference_frequency", get_reference_frequency, METH_NOARGS,
+     "Get the nominal frequency for cycle estimates"},
+    {"has_cycle_counter", has_cycle_counter, METH_NOARGS,
+     "Whether a hardware cycle counter is available"},
+    {"get_thread_stats", get_thread_stats, METH_VARARGS, "Get statistics for a thread"},
+    {"get_all_stats", get_all_stats, METH_NOARGS, "Get statistics for all threads"},
     {"get_num_threads", get_num_threads, METH_NOARGS, "Get number of threads"},
     {"set_computation_type", set_computation_type, METH_VARARGS, "Set computation type"},
     {"get_computation_type", get_computation_type, METH_NOARGS, "Get computation type"},
+    {"define_groups", define_groups, METH_VARARGS, "Replace workers with named groups"},
+    {"get_groups", get_groups, METH_NOARGS, "Get thread IDs of all groups"},
+    {"set_thread_computation_type", set_thread_computation_type, METH_VARARGS,
+     "Set computation type for a thread"},
+    {"set_thread_affinity", set_thread_affinity, METH_VARARGS, "Pin a thread to CPUs"},
+    {"set_thread_priority", set_thread_priority, METH_VARARGS, "Set nice value of a thread"},
+    {"prefault_workers", prefault_workers, METH_NOARGS,
+     "Prefault kernel buffers of all threads and wait"},
+    {"set_thread_cache_footprint", set_thread_cache_footprint, METH_VARARGS,
+     "Set bytes kept dirty by the cache kernel for a thread"},
+    {"set_thread_waveform", set_thread_waveform, METH_VARARGS, "Set load waveform of a thread"},
+    {"set_phase_stagger", set_phase_stagger, METH_VARARGS, "Spread worker cycle phases evenly"},
+    {"get_phase_stagger", get_phase_stagger, METH_NOARGS, "Get phase stagger setting"},
+    {"set_cycle_time", set_cycle_time, METH_VARARGS,
+     "Set the duty cycle period in nanoseconds"},
+    {"get_cycle_time", get_cycle_time, METH_NOARGS,
+     "Get the duty cycle period in nanoseconds"},
     {"shutdown", shutdown_loader, METH_NOARGS, "Shutdown the CPU loader"},
     {NULL, NULL, 0, NULL}
 };
@@ -0,0 +1,673 @@
+#define _GNU_SOURCE
+#include "cpu_loader_engine.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+WorkerThread *workers = NULL;
+int num_threads = 0;
+ComputationType global_compute_type = COMPUTE_BUSY_WAIT;
+bool global_phase_stagger = false;
+long long phase_epoch_ns = 0;  // common reference for all phase slots
+WorkerGroup *groups = NULL;
+int num_groups = 0;
+pthread_mutex_t global_lock = PTHREAD_MUTEX_INITIALIZER;
+// Nominal core frequency, used to estimate cycles from CPU time when no
+// hardware cycle counter is available
+double reference_hz = 0.0;
+// Duty cycle period of new workers, copied into every worker when changed
+long long cycle_time_ns = DEFAULT_CYCLE_TIME_NS;
+
+// Sleep until an absolute CLOCK_MONOTONIC time
+void sleep_until_ns(long long target_ns) {
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec = target_ns / 1000000000LL;
+    ts.tv_nsec = target_ns % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+        // Interrupted, sleep again towards the same deadline
+    }
+#else
+    long long remaining = target_ns - get_time_ns();
+    if (remaining > 0) {
+        struct timespec ts;
+        ts.tv_sec = remaining / 1000000000LL;
+        ts.tv_nsec = remaining % 1000000000LL;
+        nanosleep(&ts, NULL);
+    }
+#endif
+}
+
+// Start of the next cycle slot for a phase-staggered worker.
+// Workers are spread evenly across one cycle, so slot offsets are
+// thread_id * cycle_ns / num_threads relative to the shared epoch.
+// A worker that is only slightly late (up to a quarter cycle) keeps its
+// current slot instead of skipping a whole cycle.
+static long long staggered_cycle_start(const WorkerThread *worker, int total, long long now,
+                                       long long cycle_ns) {
+    long long offset = (long long)worker->thread_id * cycle_ns / total;
+    long long base = phase_epoch_ns + offset;
+    long long late = now - cycle_ns / 4 - base;
+    if (late <= 0) {
+        return base;
+    }
+    return base + ((late + cycle_ns - 1) / cycle_ns) * cycle_ns;
+}
+
+// Kernel thread ID of the calling thread
+long current_tid(void) {
+#ifdef __linux__
+    return (long)syscall(SYS_gettid);
+#else
+    return (long)getpid();
+#endif
+}
+
+// Modulate a base load with the worker's waveform at time now_ns
+static double apply_waveform(const WorkerThread *worker, double load, long long now_ns) {
+    if (worker->waveform == WAVE_CONSTANT || worker->wave_period_ns <= 0) {
+        return load;
+    }
+
+    double phase = (double)((now_ns - phase_epoch_ns) % worker->wave_period_ns) /
+                   worker->wave_period_ns;
+    double shape;
+    switch (worker->waveform) {
+        case WAVE_SINE:
+            shape = sin(2.0 * M_PI * phase);
+            break;
+        case WAVE_SQUARE:
+            shape = phase < 0.5 ? 1.0 : -1.0;
+            break;
+        case WAVE_TRIANGLE:
+            shape = phase < 0.5 ? 4.0 * phase - 1.0 : 3.0 - 4.0 * phase;
+            break;
+        case WAVE_SAWTOOTH:
+        default:
+            shape = 2.0 * phase - 1.0;
+            break;
+    }
+
+    load += worker->wave_amplitude * shape;
+    if (load < 0.0) return 0.0;
+    if (load > 1.0) return 1.0;
+    return load;
+}
+
+
+void init_kernel_state(KernelState *state) {
+    memset(state, 0, sizeof(*state));
+    state->prime_candidate = 1000;  // Start from a reasonable number
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            state->mat_a[i][j] = i * 4 + j + 1;
+            state->mat_b[i][j] = 16 - (i * 4 + j);
+        }
+    }
+}
+
+// PI calculation using Leibniz formula (1 op = one series term)
+static long long pi_batch(KernelState *state) {
+    double pi = state->pi_sum;
+    long long i = state->pi_term;
+
+    for (int batch = 0; batch < 100; batch++) {
+        pi += (i % 2 == 0 ? 1.0 : -1.0) / (2 * i + 1);
+        i++;
+    }
+
+    state->pi_sum = pi;
+    state->pi_term = i;
+    return 100;
+}
+
+// Prime number checking
+static bool is_prime_quick(long long n) {
+    if (n < 2) return false;
+    if (n == 2) return true;
+    if (n % 2 == 0) return false;
+
+    for (long long i = 3; i * i <= n; i += 2) {
+        if (n % i == 0) return false;
+    }
+    return true;
+}
+
+// Prime number finding (1 op = one candidate tested)
+static long long primes_batch(KernelState *state) {
+    long long n = state->prime_candidate;
+    int found = 0;
+
+    for (int batch = 0; batch < 16; batch++) {
+        found += is_prime_quick(n);
+        n++;
+        if (n > 100000) n = 1000; // Reset to avoid overflow
+    }
+
+    state->prime_candidate = n;
+    state->sink = found;
+    return 16;
+}
+
+// Simple matrix multiplication (1 op = one 4x4 matrix product)
+static long long matrix_batch(KernelState *state) {
+    for (int batch = 0; batch < 32; batch++) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                double sum = 0;
+                for (int k = 0; k < 4; k++) {
+                    sum += state->mat_a[i][k] * state->mat_b[k][j];
+                }
+                state->mat_result[i][j] = sum;
+            }
+        }
+        // Vary matrices slightly to prevent optimization
+        state->mat_a[0][0] = state->mat_result[0][0] / 1000000.0;
+    }
+    return 32;
+}
+
+// Lightweight computational work (1 op = one arithmetic step)
+static long long fibonacci_batch(KernelState *state) {
+    int counter = state->fib_counter;
+    double result = 0.0;
+
+    for (int i = 0; i < 100; i++) {
+        result += counter * 1.1 + 0.5;
+        counter = (counter + 1) % 1000;
+    }
+    state->sink += result;
+    state->fib_counter = counter;
+
+    // Small computational pause
+    struct timespec tiny_pause = {0, 5000}; // 5 microseconds
+    nanosleep(&tiny_pause, NULL);
+    return 100;
+}
+
+// Streaming memory copy (1 op = one byte read or written).
+// The buffer is split in two halves; each batch copies one chunk from the
+// first half to the second, walking through the whole buffer so the data
+// comes from DRAM rather than cache.
+// Allocate the stream buffer and touch every page so page faults do not
+// count as bandwidth. Returns false if the buffer cannot be allocated.
+bool prefault_stream_buffer(KernelState *state) {
+    if (state->stream_buf == NULL) {
+        state->stream_buf = malloc(STREAM_BUFFER_BYTES);
+        if (state->stream_buf == NULL) {
+            return false;
+        }
+        memset(state->stream_buf, 1, STREAM_BUFFER_BYTES);
+    }
+    return true;
+}
+
+static long long stream_batch(KernelState *state) {
+    const size_t half = STREAM_BUFFER_BYTES / 2 / sizeof(double);
+
+    if (!prefault_stream_buffer(state)) {
+        return 0;
+    }
+
+    double *src = state->stream_buf + state->stream_pos;
+    double *dst = state->stream_buf + half + state->stream_pos;
+    for (int i = 0; i < STREAM_CHUNK_DOUBLES; i++) {
+        dst[i] = src[i] * 1.000001;
+    }
+
+    state->stream_pos += STREAM_CHUNK_DOUBLES;
+    if (state->stream_pos + STREAM_CHUNK_DOUBLES > half) {
+        state->stream_pos = 0;
+    }
+    return 2L * STREAM_CHUNK_DOUBLES * sizeof(double);
+}
+
+// Dirty every cache line of a footprint-sized buffer once
+// (1 op = one cache line written). Returns -1 if the buffer cannot be
+// allocated.
+long long cache_sweep(KernelState *state, size_t footprint) {
+    if (state->cache_size != footprint) {
+        free(state->cache_buf);
+        state->cache_buf = malloc(footprint);
+        state->cache_size = state->cache_buf != NULL ? footprint : 0;
+        if (state->cache_buf == NULL) {
+            return -1;
+        }
+        memset(state->cache_buf, 0, footprint);
+    }
+
+    unsigned char *buf = state->cache_buf;
+    for (size_t i = 0; i < footprint; i += CACHE_LINE_BYTES) {
+        buf[i]++;
+    }
+    return (long long)(footprint / CACHE_LINE_BYTES);
+}
+
+// Release kernel buffers when a worker exits
+void free_kernel_state(KernelState *state) {
+    free(state->stream_buf);
+    state->stream_buf = NULL;
+    free(state->cache_buf);
+    state->cache_buf = NULL;
+    state->cache_size = 0;
+}
+
+// Run one short batch of the given kernel, returns the number of ops done.
+// Batches take at most a few microseconds so callers can check their time
+// or ops budget between them.
+long long run_kernel_batch(ComputationType type, KernelState *state) {
+    switch (type) {
+        case COMPUTE_PI_CALCULATION:
+            return pi_batch(state);
+
+        case COMPUTE_PRIME_NUMBERS:
+            return primes_batch(state);
+
+        case COMPUTE_MATRIX_MULTIPLY:
+            return matrix_batch(state);
+
+        case COMPUTE_FIBONACCI:
+            return fibonacci_batch(state);
+
+        case COMPUTE_MEMORY_STREAM:
+            return stream_batch(state);
+
+        case COMPUTE_BUSY_WAIT:
+        default:
+            // Busy loop (1 op = one timer poll)
+            get_time_ns();
+            return 1;
+    }
+}
+
+// Perform computation based on type for specified duration, returns ops done
+long long perform_computation(ComputationType type, KernelState *state,
+                                     long long duration_ns) {
+    long long start = get_time_ns();
+    long long ops = 0;
+
+    while ((get_time_ns() - start) < duration_ns) {
+        ops += run_kernel_batch(type, state);
+    }
+    return ops;
+}
+
+// Perform computation until target_ops are done or the deadline passes,
+// returns ops done (may overshoot the target by up to one batch)
+long long perform_ops(ComputationType type, KernelState *state,
+                             long long target_ops, long long deadline_ns) {
+    long long ops = 0;
+
+    while (ops < target_ops && get_time_ns() < deadline_ns) {
+        ops += run_kernel_batch(type, state);
+    }
+    return ops;
+}
+
+// CPU time consumed by the calling thread
+long long get_thread_cpu_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// User-space CPU time of the calling thread, the time the cycle counter
+// counts in. Falls back to the thread's whole CPU time where unavailable.
+long long get_thread_user_time_ns(void) {
+#ifdef RUSAGE_THREAD
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        return (long long)usage.ru_utime.tv_sec * 1000000000LL +
+            usage.ru_utime.tv_usec * 1000LL;
+    }
+#endif
+    return get_thread_cpu_time_ns();
+}
+
+// Open a core cycle counter for the calling thread, -1 if unavailable
+int open_cycle_counter(void) {
+    // Forces the CPU time estimate, e.g. to test hosts without perf access
+    if (getenv("CPU_LOADER_NO_CYCLE_COUNTER") != NULL) {
+        return -1;
+    }
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    // User-space cycles only, allowed with the default perf_event_paranoid
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Report how long the counter actually ran to correct for multiplexing
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+// Whether the calling thread can open a core cycle counter
+bool cycle_counter_available(void) {
+    int counter = open_cycle_counter();
+    if (counter < 0) {
+        return false;
+    }
+    close(counter);
+    return true;
+}
+
+// Core cycles consumed by the calling thread. Without a counter they are
+// estimated from its CPU time at the reference frequency.
+long long read_cpu_cycles(int counter_fd) {
+    if (counter_fd >= 0) {
+        // Count, time enabled and time running
+        unsigned long long values[3];
+        if (read(counter_fd, values, sizeof(values)) == sizeof(values)) {
+            // With more events than hardware counters the kernel multiplexes
+            // them, so the count covers only part of the time enabled
+            if (values[2] > 0 && values[2] < values[1]) {
+                return (long long)((double)values[0] * values[1] / values[2]);
+            }
+            return (long long)values[0];
+        }
+    }
+    return (long long)(get_thread_cpu_time_ns() * reference_hz / 1e9);
+}
+
+// Fold one finished cycle into the worker statistics
+static void record_cycle(WorkerThread *worker, long long ops, long long busy_ns,
+                         long long cpu_cycles, long long cycle_ns, long long period_ns) {
+    if (cycle_ns <= 0) {
+        return;
+    }
+
+    long long cpu_time_ns = get_thread_cpu_time_ns();
+    long long user_time_ns = get_thread_user_time_ns();
+    long long jitter_ns = llabs(cycle_ns - period_ns);
+    int bucket = 0;
+    while (bucket < JITTER_BUCKETS - 1 && (jitter_ns >> bucket) != 0) {
+        bucket++;
+    }
+
+    pthread_mutex_lock(&worker->lock);
+    worker->cpu_time_ns = cpu_time_ns;
+    worker->user_time_ns = user_time_ns;
+    worker->cpu_cycles += cpu_cycles;
+    worker->cpu_cycles_rate += STATS_SMOOTHING *
+        (cpu_cycles * 1e9 / cycle_ns - worker->cpu_cycles_rate);
+    worker->total_ops += ops;
+    worker->busy_ns += busy_ns;
+    worker->cycles++;
+    worker->achieved_load += STATS_SMOOTHING *
+        ((double)busy_ns / cycle_ns - worker->achieved_load);
+    worker->ops_rate += STATS_SMOOTHING *
+        (ops * 1e9 / cycle_ns - worker->ops_rate);
+    worker->jitter_hist[bucket]++;
+    worker->jitter_sum_ns += jitter_ns;
+    if (jitter_ns > worker->jitter_max_ns) {
+        worker->jitter_max_ns = jitter_ns;
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
+
+static void *worker_thread(void *arg) {
+    WorkerThread *worker = (WorkerThread *)arg;
+    KernelState state;
+    double ops_debt = 0.0;  // ops owed in throughput mode, carried across cycles
+    double cycles_debt = 0.0;  // core cycles owed in cycles mode
+    int cycle_counter = open_cycle_counter();
+
+    init_kernel_state(&state);
+
+    pthread_mutex_lock(&worker->lock);
+    worker->tid = current_tid();
+    worker->cycles_counted = cycle_counter >= 0;
+    pthread_mutex_unlock(&worker->lock);
+
+    long long last_cpu_cycles = read_cpu_cycles(cycle_counter);
+
+    while (!worker->stop) {
+        long long cycle_start = get_time_ns();
+
+        pthread_mutex_lock(&worker->lock);
+        bool stagger = worker->stagger;
+        long long cycle_ns = worker->cycle_ns;
+        bool prefault = worker->prefault;
+        size_t prefault_footprint = worker->cache_footprint;
+        pthread_mutex_unlock(&worker->lock);
+
+        if (prefault) {
+            // Allocate and touch the buffers of all kernels up front so their
+            // page faults do not land in measured cycles
+            prefault_stream_buffer(&state);
+            cache_sweep(&state, prefault_footprint);
+
+            pthread_mutex_lock(&worker->lock);
+            worker->prefault = false;
+            pthread_mutex_unlock(&worker->lock);
+            continue;
+        }
+
+        if (stagger) {
+            // Wait for this worker's phase slot so cycles do not beat
+            cycle_start = staggered_cycle_start(worker, num_threads, cycle_start, cycle_ns);
+            sleep_until_ns(cycle_start);
+        }
+
+        pthread_mutex_lock(&worker->lock);
+        if (worker->applied_seq != worker->load_seq) {
+            // New settings take effect with this cycle
+            worker->applied_seq = worker->load_seq;
+            worker->applied_ns = get_time_ns();
+        }
+        double load = apply_waveform(worker, worker->load, cycle_start);
+        double target_ops = worker->target_ops;
+        double target_cpu_cycles = worker->target_cpu_cycles;
+        ComputationType compute_type = worker->compute_type;
+        size_t cache_footprint = worker->cache_footprint;
+        pthread_mutex_unlock(&worker->lock);
+
+        long long ops = 0;
+        long long busy_ns = 0;
+
+        if (target_cpu_cycles <= 0.0) {
+            cycles_debt = 0.0;
+        }
+
+        if (compute_type == COMPUTE_CACHE_POLLUTE) {
+            // Cache polluter: any load enables it. One sweep per cycle is the
+            // lowest rate that keeps the footprint resident against
+            // neighbors; beyond that the load is the share of the cycle spent
+            // sweeping, refreshing the lines more often to hold them harder.
+            ops_debt = 0.0;
+            if (load > 0.0 || target_ops > 0.0) {
+                long long work_start = get_time_ns();
+                long long work_end = work_start + (long long)(load * cycle_ns);
+                do {
+                    long long swept = cache_sweep(&state, cache_footprint);
+                    if (swept < 0) {
+                        break;
+                    }
+                    ops += swept;
+                } while (get_time_ns() < work_end);
+                busy_ns = get_time_ns() - work_start;
+            }
+            sleep_until_ns(cycle_start + cycle_ns);
+        } else if (target_cpu_cycles > 0.0 && (cycle_counter >= 0 || reference_hz > 0.0)) {
+            // Cycles mode: spend this cycle's share of the target core cycles
+            // in short slices, checking the counter in between. The work
+            // delivered stays constant when the clock speed changes, the CPU
+            // time floats. Debt is carried over like in throughput mode.
+            // With neither a counter nor a reference frequency no cycles can
+            // be counted, and the thread keeps its duty cycle instead of
+            // running at 100% for a quota it never reaches.
+            double quota = target_cpu_cycles * cycle_ns / 1e9;
+            long long deadline = cycle_start + cycle_ns;
+            long long work_start = get_time_ns();
+            long long cycles_start = read_cpu_cycles(cycle_counter);
+            long long spent = 0;
+
+            ops_debt = 0.0;
+            cycles_debt += quota;
+            while (spent < cycles_debt && get_time_ns() < deadline) {
+                ops += perform_computation(compute_type, &state, CPU_CYCLES_SLICE_NS);
+                spent = read_cpu_cycles(cycle_counter) - cycles_start;
+            }
+            cycles_debt -= spent;
+            if (cycles_debt > quota) {
+                cycles_debt = quota;
+            }
+            busy_ns = get_time_ns() - work_start;
+
+            sleep_until_ns(deadline);
+        } else if (target_ops > 0.0) {
+            // Throughput mode: deliver this cycle's share of the target rate
+            // and sleep for whatever time is left. Ops that did not fit are
+            // carried over, but at most one cycle's worth so a long stall
+            // does not turn into a burst afterwards.
+            double quota = target_ops * cycle_ns / 1e9;
+            long long deadline = cycle_start + cycle_ns;
+            long long work_start = get_time_ns();
+
+            ops_debt += quota;
+            ops = perform_ops(compute_type, &state, (long long)ops_debt, deadline);
+            ops_debt -= ops;
+            if (ops_debt > quota) {
+                ops_debt = quota;
+            }
+            busy_ns = get_time_ns() - work_start;
+
+            sleep_until_ns(deadline);
+        } else if (load <= 0.0) {
+            // No load, sleep for the full cycle
+            ops_debt = 0.0;
+            struct timespec sleep_time = {0, cycle_ns};
+            nanosleep(&sleep_time, NULL);
+        } else if (load >= 1.0) {
+            // 100% load, perform computation for the entire cycle
+            ops_debt = 0.0;
+            long long work_start = get_time_ns();
+            ops = perform_computation(compute_type, &state, cycle_ns);
+            busy_ns = get_time_ns() - work_start;
+        } else {
+            // Partial load
+            ops_debt = 0.0;
+            long long work_time_ns = (long long)(load * cycle_ns);
+
+            // Perform computation for work time
+            long long work_start = get_time_ns();
+            ops = perform_computation(compute_type, &state, work_time_ns);
+            busy_ns = get_time_ns() - work_start;
+
+            // Sleep for the rest of the cycle. Short remainders are slept
+            // too, skipping them would run short cycles at close to 100%.
+            sleep_until_ns(cycle_start + cycle_ns);
+        }
+
+        long long cpu_cycles = read_cpu_cycles(cycle_counter);
+        record_cycle(worker, ops, busy_ns, cpu_cycles - last_cpu_cycles,
+                     get_time_ns() - cycle_start, cycle_ns);
+        last_cpu_cycles = cpu_cycles;
+    }
+
+    if (cycle_counter >= 0) {
+        close(cycle_counter);
+    }
+    free_kernel_state(&state);
+    return NULL;
+}
+
+// Change a worker's load and return it to duty-cycle mode
+void set_worker_load(WorkerThread *worker, double load) {
+    pthread_mutex_lock(&worker->lock);
+    worker->load = load;
+    worker->target_ops = 0.0;
+    worker->target_cpu_cycles = 0.0;
+    worker->load_seq++;
+    pthread_mutex_unlock(&worker->lock);
+}
+
+// Stop and free all workers (caller holds global_lock)
+void stop_workers(void) {
+    if (workers != NULL) {
+        for (int i = 0; i < num_threads; i++) {
+            workers[i].stop = true;
+        }
+        for (int i = 0; i < num_threads; i++) {
+            pthread_join(workers[i].thread, NULL);
+            pthread_mutex_destroy(&workers[i].lock);
+        }
+        free(workers);
+        workers = NULL;
+        num_threads = 0;
+    }
+
+    free(groups);
+    groups = NULL;
+    num_groups = 0;
+}
+
+// Allocate and start new workers (caller holds global_lock).
+// Returns 0 on success, -1 if a thread cannot be created.
+int start_workers(int new_num_threads) {
+    workers = calloc(new_num_threads, sizeof(WorkerThread));
+    if (workers == NULL) {
+        num_threads = 0;
+        return -1;
+    }
+    num_threads = new_num_threads;
+    phase_epoch_ns = get_time_ns();
+
+    // Start threads
+    for (int i = 0; i < num_threads; i++) {
+        workers[i].thread_id = i;
+        workers[i].load = 0.0;
+        workers[i].running = false;
+        workers[i].stop = false;
+        workers[i].compute_type = global_compute_type;
+        workers[i].stagger = global_phase_stagger;
+        workers[i].cycle_ns = cycle_time_ns;
+        workers[i].target_ops = 0.0;
+        workers[i].target_cpu_cycles = 0.0;
+        workers[i].group_id = -1;
+        workers[i].waveform = WAVE_CONSTANT;
+        workers[i].cache_footprint = CACHE_DEFAULT_FOOTPRINT;
+        pthread_mutex_init(&workers[i].lock, NULL);
+
+        if (pthread_create(&workers[i].thread, NULL, worker_thread, &workers[i]) != 0) {
+            // Workers before i are running and stopped by stop_workers()
+            pthread_mutex_destroy(&workers[i].lock);
+            num_threads = i;
+            return -1;
+        }
+        workers[i].running = true;
+    }
+
+    // Wait until every worker has published its kernel thread ID, so
+    // priorities can be applied right after initialization
+    for (int i = 0; i < num_threads; i++) {
+        for (;;) {
+            pthread_mutex_lock(&workers[i].lock);
+            long tid = workers[i].tid;
+            pthread_mutex_unlock(&workers[i].lock);
+            if (tid != 0) {
+                break;
+            }
+            struct timespec pause = {0, 50000};
+            nanosleep(&pause, NULL);
+        }
+    }
+
+    return 0;
+}
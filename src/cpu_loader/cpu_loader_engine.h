@@ -0,0 +1,181 @@
+// Load generation engine: worker threads, computation kernels and timing.
+// Shared by the Python extension (cpu_loader_core.c) and the native engine
+// benchmark (cpu_loader_bench.c). All settings and statistics live in the
+// workers array; writers take global_lock and then the worker's lock,
+// workers only ever take their own lock.
+#ifndef CPU_LOADER_ENGINE_H
+#define CPU_LOADER_ENGINE_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+#define DEFAULT_CYCLE_TIME_NS 10000000L  // 10ms in nanoseconds for better responsiveness
+#define MIN_CYCLE_TIME_NS 1000000L  // 1ms
+#define MAX_CYCLE_TIME_NS 100000000L  // 100ms
+#define STATS_SMOOTHING 0.1       // EWMA weight of the newest cycle in worker stats
+#define STREAM_BUFFER_BYTES (64L * 1024 * 1024)  // per worker, well beyond typical LLC sizes
+#define STREAM_CHUNK_DOUBLES 8192  // 64 KiB copied per stream batch
+#define CACHE_LINE_BYTES 64
+#define CACHE_DEFAULT_FOOTPRINT (8L * 1024 * 1024)  // per worker if none is set
+#define CACHE_MAX_FOOTPRINT (1L << 30)  // per worker, far beyond any LLC
+#define CPU_CYCLES_SLICE_NS 20000L  // work between counter reads in cycles mode
+#define JITTER_BUCKETS 32  // power-of-two ns buckets, the last one open-ended
+
+// Computation types for busy-wait
+typedef enum {
+    COMPUTE_BUSY_WAIT = 0,
+    COMPUTE_PI_CALCULATION = 1,
+    COMPUTE_PRIME_NUMBERS = 2,
+    COMPUTE_MATRIX_MULTIPLY = 3,
+    COMPUTE_FIBONACCI = 4,
+    COMPUTE_MEMORY_STREAM = 5,
+    COMPUTE_CACHE_POLLUTE = 6
+} ComputationType;
+
+#define COMPUTE_TYPE_LAST COMPUTE_CACHE_POLLUTE
+
+// Load waveforms, modulating a worker's load around its base value
+typedef enum {
+    WAVE_CONSTANT = 0,
+    WAVE_SINE = 1,
+    WAVE_SQUARE = 2,
+    WAVE_TRIANGLE = 3,
+    WAVE_SAWTOOTH = 4
+} WaveformType;
+
+#define MAX_GROUP_NAME 64
+
+// Named group of consecutive workers
+typedef struct {
+    char name[MAX_GROUP_NAME];
+    int first_thread;
+    int count;
+} WorkerGroup;
+
+typedef struct {
+    pthread_t thread;
+    int thread_id;
+    double load;  // 0.0 to 1.0
+    bool running;
+    bool stop;
+    ComputationType compute_type;
+    bool stagger;  // align cycle start to this worker's phase slot
+    long long cycle_ns;  // duty cycle period
+    double target_ops;  // ops per second, 0.0 = duty-cycle mode
+    double target_cpu_cycles;  // core cycles per second, 0.0 = other modes
+    unsigned long long load_seq;  // incremented on every load or target change
+    unsigned long long applied_seq;  // load_seq of the settings the worker runs
+    long long applied_ns;  // CLOCK_MONOTONIC time the worker picked them up
+    long tid;  // kernel thread ID, published by the worker when it starts
+    int group_id;  // index into groups, -1 if not part of a group
+    WaveformType waveform;
+    long long wave_period_ns;
+    double wave_amplitude;  // 0.0 to 1.0, added to and subtracted from load
+    size_t cache_footprint;  // bytes kept dirty by the cache kernel
+    bool prefault;  // set to request kernel buffer prefaulting, cleared when done
+    // Statistics, updated by the worker once per cycle
+    unsigned long long total_ops;
+    long long busy_ns;
+    long long cycles;
+    long long cpu_time_ns;  // CPU time consumed by the worker thread
+    long long user_time_ns;  // user-space part of cpu_time_ns, what cpu_cycles cover
+    double achieved_load;  // smoothed fraction of each cycle spent computing
+    double ops_rate;  // smoothed ops per second
+    unsigned long long cpu_cycles;  // core cycles consumed by the worker thread
+    double cpu_cycles_rate;  // smoothed core cycles per second
+    bool cycles_counted;  // cpu_cycles come from a hardware counter
+    // Cycle duration jitter |duration - period|. Bucket 0 counts exact
+    // cycles, bucket b jitter in [2^(b-1), 2^b) ns.
+    unsigned long long jitter_hist[JITTER_BUCKETS];
+    unsigned long long jitter_sum_ns;
+    long long jitter_max_ns;
+    pthread_mutex_t lock;
+} WorkerThread;
+
+// Per-worker kernel state, kept across batches so work continues where it
+// left off and the compiler cannot discard the results
+typedef struct {
+    double pi_sum;
+    long long pi_term;
+    long long prime_candidate;
+    double mat_a[4][4];
+    double mat_b[4][4];
+    double mat_result[4][4];
+    int fib_counter;
+    double *stream_buf;  // allocated on first use of the stream kernel
+    size_t stream_pos;
+    unsigned char *cache_buf;  // sized to the worker's cache footprint
+    size_t cache_size;
+    volatile double sink;
+} KernelState;
+
+extern WorkerThread *workers;
+extern int num_threads;
+extern ComputationType global_compute_type;
+extern bool global_phase_stagger;
+extern long long phase_epoch_ns;
+extern WorkerGroup *groups;
+extern int num_groups;
+extern pthread_mutex_t global_lock;
+// Nominal core frequency, used to estimate cycles from CPU time when no
+// hardware cycle counter is available
+extern double reference_hz;
+// Duty cycle period of new workers, copied into every worker when changed
+extern long long cycle_time_ns;
+
+// High-resolution timer
+static inline long long get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Sleep until an absolute CLOCK_MONOTONIC time
+void sleep_until_ns(long long target_ns);
+
+// Kernel thread ID of the calling thread
+long current_tid(void);
+
+// Kernel state of a new worker, release with free_kernel_state()
+void init_kernel_state(KernelState *state);
+void free_kernel_state(KernelState *state);
+
+// Run one short batch of the given kernel, returns the number of ops done
+long long run_kernel_batch(ComputationType type, KernelState *state);
+
+// Run a kernel for a duration, returns ops done
+long long perform_computation(ComputationType type, KernelState *state,
+                              long long duration_ns);
+
+// Run a kernel until target_ops are done or the deadline passes
+long long perform_ops(ComputationType type, KernelState *state,
+                      long long target_ops, long long deadline_ns);
+
+// Allocate and touch the stream buffer, false if it cannot be allocated
+bool prefault_stream_buffer(KernelState *state);
+
+// Dirty every cache line of a footprint-sized buffer once, -1 on failure
+long long cache_sweep(KernelState *state, size_t footprint);
+
+// CPU time consumed by the calling thread, in total and in user space
+long long get_thread_cpu_time_ns(void);
+long long get_thread_user_time_ns(void);
+
+// User-space core cycle counter of the calling thread, -1 if unavailable
+int open_cycle_counter(void);
+bool cycle_counter_available(void);
+long long read_cpu_cycles(int counter_fd);
+
+// Change a worker's load and return it to duty-cycle mode
+void set_worker_load(WorkerThread *worker, double load);
+
+// Stop and free all workers (caller holds global_lock)
+void stop_workers(void);
+
+// Allocate and start new workers (caller holds global_lock).
+// Returns 0 on success, -1 if a thread cannot be created.
+int start_workers(int new_num_threads);
+
+#endif  // CPU_LOADER_ENGINE_H
@@ -5,6 +5,7 @@ Provides REST API and WebUI for controlling CPU load.
 
 import argparse
 import asyncio
+import json
 import logging
 from contextlib import asynccontextmanager
 from pathlib import Path
@@ -17,8 +18,21 @@ from fastapi.responses import FileResponse, HTMLResponse
 from fastapi.staticfiles import StaticFiles
 from pydantic import BaseModel, Field
 
-from cpu_loader.cpu_loader import CPULoader
+from cpu_loader.calibration import DEFAULT_CACHE_PATH, CalibrationCache
+from cpu_loader.controllers import (
+    HostTargetController,
+    MemoryBandwidthController,
+    PowerController,
+    PressureController,
+    ShadowController,
+    ThermalController,
+    YieldController,
+)
+from cpu_loader.cpu_loader import ComputationType, CPULoader
 from cpu_loader.mqtt_publisher import MQTTPublisher
+from cpu_loader.overhead import OverheadMeter
+from cpu_loader.sensors import read_cpu_temperature, read_pressure_summary
+from cpu_loader.victim import create_victim, run_sweep
 
 # Configure logging
 logging.basicConfig(
@@ -40,6 +54,192 @@ class AllThreadsLoadRequest(BaseModel):
     )
 
 
+class CoreBudgetRequest(BaseModel):
+    cores: float = Field(..., ge=0, description="Total load in cores (e.g. 3.7)")
+    distribution: str = Field(
+        "spread", description="Distribution across threads: pack or spread"
+    )
+
+
+class CacheFootprintRequest(BaseModel):
+    footprint_mb: float = Field(..., ge=0, description="Total cache footprint in MiB")
+    group: Optional[str] = Field(None, description="Only use the threads of this group")
+    intensity_percent: float = Field(
+        1.0, gt=0, le=100, description="Share of each cycle spent sweeping"
+    )
+
+
+class GroupsDefinitionRequest(BaseModel):
+    groups: Dict[str, int] = Field(
+        ..., description="Mapping of group name to number of threads"
+    )
+
+
+class WaveformSettings(BaseModel):
+    shape: str = Field(
+        ..., description="Waveform: constant, sine, square, triangle, sawtooth"
+    )
+    period_ms: float = Field(1000.0, gt=0, description="Waveform period in ms")
+    amplitude_percent: float = Field(
+        0.0, ge=0, le=100, description="Swing around the base load in percent"
+    )
+
+
+class GroupSettingsRequest(BaseModel):
+    load_percent: Optional[float] = Field(
+        None, ge=0, le=100, description="Load percentage for every thread"
+    )
+    ops_per_sec: Optional[float] = Field(
+        None, ge=0, description="Throughput target for the whole group"
+    )
+    computation_type: Optional[str] = Field(None, description="Computation type")
+    cpus: Optional[List[int]] = Field(
+        None, description="CPUs to pin the group to (empty list = all CPUs)"
+    )
+    nice: Optional[int] = Field(None, ge=-20, le=19, description="Nice value")
+    waveform: Optional[WaveformSettings] = None
+
+
+class ShadowControlRequest(BaseModel):
+    pid: Optional[int] = Field(None, gt=0, description="Process to mirror")
+    cgroup: Optional[str] = Field(
+        None, description="cgroup to mirror (path below /sys/fs/cgroup)"
+    )
+    mode: str = Field("replicate", description="replicate, scale or invert")
+    factor: float = Field(1.0, ge=0, description="Multiplier for scale mode")
+    capacity: Optional[float] = Field(
+        None, gt=0, description="Cores the target could use (invert mode)"
+    )
+    interval_ms: float = Field(100.0, gt=0, description="Sampling interval in ms")
+    distribution: str = Field("spread", description="pack or spread")
+    subtract_overhead: bool = Field(
+        False, description="Take the loader's control plane CPU off the budget"
+    )
+
+
+class HostTargetControlRequest(BaseModel):
+    target_percent: float = Field(
+        ..., ge=0, le=100, description="Target total host CPU utilization"
+    )
+    gain: float = Field(
+        0.5, gt=0, le=1, description="Fraction of the error corrected per step"
+    )
+    interval_ms: float = Field(1000.0, gt=0, description="Control interval in ms")
+    distribution: str = Field("spread", description="pack or spread")
+
+
+class PressureControlRequest(BaseModel):
+    target_percent: float = Field(
+        ..., ge=0, le=100, description="Target CPU 'some' stall percentage"
+    )
+    cgroup: Optional[str] = Field(
+        None, description="Use this cgroup's cpu.pressure instead of the host's"
+    )
+    gain: float = Field(
+        0.05, gt=0, description="Cores per percentage point of error and step"
+    )
+    interval_ms: float = Field(1000.0, gt=0, description="Control interval in ms")
+    distribution: str = Field("spread", description="pack or spread")
+
+
+class ThermalControlRequest(BaseModel):
+    target_celsius: float = Field(..., description="Package temperature to hold")
+    ceiling_celsius: Optional[float] = Field(
+        None, description="Hard limit, defaults to 10 degrees above target"
+    )
+    kp: float = Field(0.05, ge=0, description="Proportional gain per degree")
+    ki: float = Field(0.005, ge=0, description="Integral gain per degree-second")
+    kd: float = Field(0.0, ge=0, description="Derivative gain per degree/second")
+    max_rate: float = Field(
+        0.05, gt=0, description="Maximum load fraction change per second"
+    )
+    interval_ms: float = Field(1000.0, gt=0, description="Control interval in ms")
+    distribution: str = Field("spread", description="pack or spread")
+
+
+class PowerControlRequest(BaseModel):
+    target_watts: float = Field(..., gt=0, description="Package power to hold")
+    kernels: Optional[List[str]] = Field(
+        None, description="Computation types from least to most intense"
+    )
+    gain: Optional[float] = Field(
+        None, gt=0, description="Cores per watt of error and step"
+    )
+    interval_ms: float = Field(1000.0, gt=0, description="Control interval in ms")
+    distribution: str = Field("spread", description="pack or spread")
+
+
+class BandwidthControlRequest(BaseModel):
+    target_gbps: float = Field(..., gt=0, description="Aggregate GB/s to hold")
+    gain: float = Field(
+        0.5, gt=0, le=1, description="Damping of the multiplicative correction"
+    )
+    interval_ms: float = Field(500.0, gt=0, description="Control interval in ms")
+    distribution: str = Field("spread", description="pack or spread")
+
+
+class YieldControlRequest(BaseModel):
+    pid: Optional[int] = Field(None, gt=0, description="Process to protect")
+    cgroup: Optional[str] = Field(
+        None, description="cgroup to protect (path below /sys/fs/cgroup)"
+    )
+    threshold_us: float = Field(
+        500.0, gt=0, description="Runqueue delay per timeslice that triggers backoff"
+    )
+    resume_us: Optional[float] = Field(
+        None, ge=0, description="Delay below which load grows again (default half)"
+    )
+    increase: float = Field(0.25, gt=0, description="Cores added per step")
+    decrease: float = Field(0.5, gt=0, lt=1, description="Budget multiplier on backoff")
+    max_cores: Optional[float] = Field(
+        None, gt=0, description="Upper limit of the harvested cores"
+    )
+    interval_ms: float = Field(500.0, gt=0, description="Control interval in ms")
+    distribution: str = Field("spread", description="pack or spread")
+
+
+class VictimRequest(BaseModel):
+    mode: str = Field("task", description="task (timed loop) or echo (loopback TCP)")
+    rate: float = Field(1000.0, gt=0, description="Requests per second")
+    work_us: Optional[float] = Field(
+        None, ge=0, description="CPU time per request in us (task default 100)"
+    )
+    payload_bytes: int = Field(64, gt=0, description="Echo payload size")
+
+
+class VictimSweepRequest(BaseModel):
+    levels: List[float] = Field(
+        [0, 25, 50, 75, 100], description="Load percentages to measure"
+    )
+    duration_s: float = Field(5.0, gt=0, description="Recording time per level")
+    settle_s: float = Field(1.0, ge=0, description="Wait after each load change")
+    computation_type: Optional[str] = Field(
+        None, description="Kernel to run during the sweep (default: current)"
+    )
+
+
+class WarmupRequest(BaseModel):
+    kernels: Optional[List[str]] = Field(
+        None, description="Computation types to warm up (default: current)"
+    )
+    max_seconds: float = Field(10.0, gt=0, description="Time limit per kernel")
+    cv_percent: float = Field(
+        3.0, gt=0, description="Throughput variation that counts as stable"
+    )
+
+
+class OpsTargetRequest(BaseModel):
+    ops_per_sec: float = Field(
+        ..., ge=0, description="Target kernel ops per second (0 = duty-cycle mode)"
+    )
+
+
+class CyclesTargetRequest(BaseModel):
+    cycles_per_sec: float = Field(
+        ..., ge=0, description="Target core cycles per second (0 = duty-cycle mode)"
+    )
+
+
 class ThreadCountRequest(BaseModel):
     num_threads: int = Field(
         ..., gt=0, description="Number of threads (must be positive)"
@@ -55,11 +255,16 @@ class CPUMetricsResponse(BaseModel):
     total_cpu_percent: float
     per_cpu_percent: List[float]
     cpu_temperature: Optional[float] = None
+    pressure: Optional[Dict[str, Dict[str, float]]] = None
+    overhead: Optional[Dict] = None
 
 
 class ComputationTypeRequest(BaseModel):
     computation_type: str = Field(
-        ..., description="Computation type: busy-wait, pi, primes, matrix, fibonacci"
+        ...,
+        description=(
+            "Computation type: busy-wait, pi, primes, matrix, fibonacci, stream, cache"
+        ),
     )
 
 
@@ -68,11 +273,22 @@ class ComputationTypeResponse(BaseModel):
     available_types: List[str]
 
 
+class PhaseStaggerRequest(BaseModel):
+    enabled: bool = Field(..., description="Spread worker cycle phases evenly")
+
+
+class CycleTimeRequest(BaseModel):
+    cycle_ms: float = Field(..., ge=1, le=100, description="Duty cycle period in ms")
+
+
 # Global CPU loader instance, MQTT publisher, and WebSocket connections
 cpu_loader = None
 mqtt_publisher: Optional[MQTTPublisher] = None
+overhead_meter: Optional[OverheadMeter] = None
+calibration_cache: Optional[CalibrationCache] = None
 websocket_connections: Set[WebSocket] = set()
 monitoring_task = None
+warmup_task: Optional[asyncio.Task] = None
 temperature_monitoring_enabled = True
 temperature_monitoring_enabled = True
 
@@ -82,30 +298,57 @@ def get_cpu_temperature() -> Optional[float]:
     if not temperature_monitoring_enabled:
         return None
 
-    try:
-        # Try to get CPU temperature using psutil
-        temperatures = psutil.sensors_temperatures()
+    return read_cpu_temperature()
+
+
+async def broadcast(message: Dict):
+    """Send a message to all connected WebSocket clients."""
+    if not websocket_connections:
+        return
+
+    disconnected = set()
+    for websocket in websocket_connections:
+        try:
+            await websocket.send_json(message)
+        except Exception:
+            disconnected.add(websocket)
+
+    # Remove disconnected clients
+    websocket_connections.difference_update(disconnected)
 
-        # Common temperature sensor names to check
-        temp_names = ["coretemp", "cpu_thermal", "acpi", "k8temp", "k10temp"]
 
-        for temp_name in temp_names:
-            if temp_name in temperatures:
-                # Get the first temperature reading
-                temp_list = temperatures[temp_name]
-                if temp_list:
-                    return round(temp_list[0].current, 1)
+def start_host_target(host_target: Optional[float]):
+    """Start filling host headroom if a host target is given."""
+    if host_target is not None:
+        cpu_loader.start_controller(HostTargetController(cpu_loader, host_target))
 
-        # If no specific sensor found, try the first available
-        for sensor_name, temp_list in temperatures.items():
-            if temp_list:
-                return round(temp_list[0].current, 1)
 
-    except (AttributeError, OSError, ImportError):
-        # Temperature monitoring not available on this system
-        pass
+async def run_warmup(host_target: Optional[float] = None, **kwargs) -> Dict:
+    """
+    Run a warm-up without blocking the event loop and announce readiness
+    over WebSocket and MQTT, then start host target control if given.
+    """
+    if mqtt_publisher:
+        mqtt_publisher.publish_ready(False)
+
+    try:
+        report = await asyncio.to_thread(cpu_loader.warmup, **kwargs)
+    finally:
+        await broadcast(
+            {
+                "type": "ready",
+                "ready": cpu_loader.is_ready(),
+                "warmup": cpu_loader.warmup_report,
+            }
+        )
+        if mqtt_publisher:
+            mqtt_publisher.publish_ready(
+                cpu_loader.is_ready(), cpu_loader.warmup_report
+            )
 
-    return None
+    logger.info(f"Warm-up finished in {report['seconds']} s, ready for measurements")
+    start_host_target(host_target)
+    return report
 
 
 async def cpu_monitoring_loop():
@@ -122,8 +365,12 @@ async def cpu_monitoring_loop():
             per_cpu = psutil.cpu_percent(interval=None, percpu=True)
             total_cpu = sum(per_cpu) / len(per_cpu) if per_cpu else 0.0
 
-            # Get CPU temperature if available
+            # Get CPU temperature and pressure stall information if available
             cpu_temp = get_cpu_temperature()
+            pressure = read_pressure_summary()
+
+            # CPU time of the loader's own control plane, apart from the workers
+            overhead = overhead_meter.sample() if overhead_meter else None
 
             # Prepare message
             message = {
@@ -131,23 +378,18 @@ async def cpu_monitoring_loop():
                 "total_cpu_percent": round(total_cpu, 1),
                 "per_cpu_percent": [round(cpu, 1) for cpu in per_cpu],
                 "cpu_temperature": cpu_temp,
+                "pressure": pressure,
+                "overhead": overhead,
             }
 
             # Broadcast to all connected clients
-            if websocket_connections:
-                disconnected = set()
-                for websocket in websocket_connections:
-                    try:
-                        await websocket.send_json(message)
-                    except Exception:
-                        disconnected.add(websocket)
-
-                # Remove disconnected clients
-                websocket_connections.difference_update(disconnected)
+            await broadcast(message)
 
             # Publish to MQTT if enabled
             if mqtt_publisher:
-                mqtt_publisher.publish_cpu_metrics(total_cpu, per_cpu, cpu_temp)
+                mqtt_publisher.publish_cpu_metrics(
+                    total_cpu, per_cpu, cpu_temp, pressure, overhead
+                )
 
         except Exception as e:
             logger.error(f"Error in CPU monitoring loop: {e}")
@@ -157,19 +399,37 @@ async def cpu_monitoring_loop():
 @asynccontextmanager
 async def lifespan(app: FastAPI):
     """Lifespan context manager for startup and shutdown events."""
-    global cpu_loader, mqtt_publisher, monitoring_task
+    global cpu_loader, mqtt_publisher, overhead_meter, calibration_cache
+    global monitoring_task, warmup_task
     # Startup
     cpu_loader = CPULoader()
+    try:
+        overhead_meter = OverheadMeter(cpu_loader)
+    except OSError as e:
+        logger.info(f"Self-overhead is not measured: {e}")
 
     # Set computation type if specified in app state
     computation_type = getattr(app.state, "computation_type", None)
     if computation_type:
         cpu_loader.set_computation_type_from_string(computation_type)
 
+    # Enable phase staggering if requested
+    if getattr(app.state, "stagger_phases", False):
+        cpu_loader.set_phase_stagger(True)
+
+    cycle_ms = getattr(app.state, "cycle_ms", None)
+    if cycle_ms:
+        cpu_loader.set_cycle_time(cycle_ms)
+
+    # Warm-ups confirm cached kernel throughput instead of waiting it out
+    cache_path = getattr(app.state, "calibration_cache", DEFAULT_CACHE_PATH)
+    if cache_path is not None:
+        calibration_cache = CalibrationCache(cache_path)
+
     # Initialize MQTT publisher with settings from arguments or environment
     mqtt_args = getattr(app.state, "mqtt_args", {})
     try:
-        mqtt_publisher = MQTTPublisher(**mqtt_args)
+        mqtt_publisher = MQTTPublisher(**mqtt_args, command_handler=apply_load_command)
     except ImportError:
         logger.warning("MQTT publishing disabled: paho-mqtt not installed")
         mqtt_publisher = None
@@ -178,8 +438,29 @@ async def lifespan(app: FastAPI):
         mqtt_publisher = None
 
     monitoring_task = asyncio.create_task(cpu_monitoring_loop())
+
+    # Warm up in the background; GET /api/ready reports when it is done.
+    # Host target control starts afterwards so it does not disturb the warm-up.
+    warmup = getattr(app.state, "warmup", None)
+    host_target = getattr(app.state, "host_target", None)
+    if warmup:
+        cpu_loader.ready = False
+        warmup_task = asyncio.create_task(
+            run_warmup(
+                max_seconds=warmup, host_target=host_target, cache=calibration_cache
+            )
+        )
+    else:
+        warmup_task = None
+        if mqtt_publisher:
+            mqtt_publisher.publish_ready(True)
+        start_host_target(host_target)
+
     yield
     # Shutdown
+    if warmup_task:
+        # The warm-up thread cannot be interrupted, let it finish
+        await asyncio.gather(warmup_task, return_exceptions=True)
     if monitoring_task:
         monitoring_task.cancel()
         try:
@@ -233,16 +514,69 @@ async def get_threads_status():
     )
 
 
+@app.get("/api/threads/stats")
+async def get_threads_stats():
+    """Get runtime statistics (ops, achieved load) of all threads."""
+    return {
+        "computation_type": cpu_loader.get_computation_type_string(),
+        "threads": cpu_loader.get_all_stats(),
+    }
+
+
+def apply_load_command(command: Dict) -> str:
+    """
+    Apply a load command received over WebSocket or MQTT.
+
+    Args:
+        command: {"load_percent": x} for all threads, with "thread_id" for one
+
+    Returns:
+        Confirmation message
+    """
+    load_percent = command.get("load_percent")
+    if isinstance(load_percent, bool) or not isinstance(load_percent, (int, float)):
+        raise ValueError("load_percent must be a number")
+
+    thread_id = command.get("thread_id")
+    if thread_id is None:
+        cpu_loader.set_all_loads(load_percent)
+        message = f"All threads set to {load_percent}%"
+    elif isinstance(thread_id, int) and not isinstance(thread_id, bool):
+        cpu_loader.set_thread_load(thread_id, load_percent)
+        message = f"Thread {thread_id} load set to {load_percent}%"
+    else:
+        raise ValueError("thread_id must be an integer")
+
+    # Publish updated settings to MQTT
+    if mqtt_publisher:
+        mqtt_publisher.publish_load_settings(
+            cpu_loader.get_num_threads(), cpu_loader.get_all_loads()
+        )
+
+    return message
+
+
 @app.websocket("/ws/cpu-metrics")
 async def websocket_cpu_metrics(websocket: WebSocket):
     """WebSocket endpoint for real-time CPU metrics."""
     await websocket.accept()
     websocket_connections.add(websocket)
     try:
-        # Keep connection alive
         while True:
-            # Wait for any message (ping/pong)
-            await websocket.receive_text()
+            # Handle load commands, anything else just keeps the connection alive
+            try:
+                message = json.loads(await websocket.receive_text())
+            except ValueError:
+                continue
+            if not isinstance(message, dict) or message.get("type") != "set_load":
+                continue
+
+            try:
+                reply = {"type": "ack", "message": apply_load_command(message)}
+            except ValueError as e:
+                reply = {"type": "error", "message": str(e)}
+            reply["id"] = message.get("id")
+            await websocket.send_json(reply)
     except WebSocketDisconnect:
         websocket_connections.discard(websocket)
     except Exception:
@@ -256,10 +590,26 @@ async def get_cpu_metrics():
     total_cpu = psutil.cpu_percent(interval=0)
     cpu_temp = get_cpu_temperature()
     return CPUMetricsResponse(
-        total_cpu_percent=total_cpu, per_cpu_percent=per_cpu, cpu_temperature=cpu_temp
+        total_cpu_percent=total_cpu,
+        per_cpu_percent=per_cpu,
+        cpu_temperature=cpu_temp,
+        pressure=read_pressure_summary(),
+        overhead=overhead_meter.last if overhead_meter else None,
     )
 
 
+@app.get("/api/overhead")
+async def get_overhead():
+    """Get the CPU usage of the loader's control plane, apart from its workers."""
+    if overhead_meter is None:
+        raise HTTPException(
+            status_code=501, detail="Self-overhead is not measured on this host"
+        )
+    if overhead_meter.last is None:
+        return overhead_meter.sample()
+    return overhead_meter.last
+
+
 @app.post("/api/threads")
 async def set_thread_count(request: ThreadCountRequest):
     """Set the number of threads."""
@@ -325,11 +675,511 @@ async def set_all_thread_loads(request: AllThreadsLoadRequest):
         raise HTTPException(status_code=400, detail=str(e))
 
 
+@app.put("/api/core-budget")
+async def set_core_budget(request: CoreBudgetRequest):
+    """Set the total load as a number of cores, packed or spread across threads."""
+    try:
+        cpu_loader.set_core_budget(request.cores, request.distribution)
+
+        # Publish updated settings to MQTT
+        if mqtt_publisher:
+            mqtt_publisher.publish_load_settings(
+                cpu_loader.get_num_threads(), cpu_loader.get_all_loads()
+            )
+
+        return {
+            "status": "success",
+            "cores": request.cores,
+            "distribution": request.distribution,
+            "loads": cpu_loader.get_all_loads(),
+            "message": f"Core budget set to {request.cores} ({request.distribution})",
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+
+@app.put("/api/threads/{thread_id}/cycles-target")
+async def set_thread_cycles_target(thread_id: int, request: CyclesTargetRequest):
+    """Set a core cycles per second target for a specific thread."""
+    try:
+        cpu_loader.set_thread_cycles_target(thread_id, request.cycles_per_sec)
+        return {
+            "status": "success",
+            "thread_id": thread_id,
+            "cycles_per_sec": request.cycles_per_sec,
+            "reference_hz": cpu_loader.get_reference_frequency(),
+            "message": (
+                f"Thread {thread_id} cycles target set to {request.cycles_per_sec}/s"
+            ),
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+
+@app.post("/api/threads/cycles-target/all")
+async def set_all_cycles_targets(request: CyclesTargetRequest):
+    """Set the same core cycles per second target for all threads."""
+    try:
+        cpu_loader.set_all_cycles_targets(request.cycles_per_sec)
+        return {
+            "status": "success",
+            "cycles_per_sec": request.cycles_per_sec,
+            "reference_hz": cpu_loader.get_reference_frequency(),
+            "message": f"All threads cycles target set to {request.cycles_per_sec}/s",
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+
+@app.put("/api/cache-footprint")
+async def set_cache_footprint(request: CacheFootprintRequest):
+    """Keep a number of megabytes of last-level cache dirty with the cache kernel."""
+    try:
+        cpu_loader.set_cache_footprint(
+            request.footprint_mb, request.group, request.intensity_percent
+        )
+
+        # Publish updated settings to MQTT
+        if mqtt_publisher:
+            mqtt_publisher.publish_load_settings(
+                cpu_loader.get_num_threads(), cpu_loader.get_all_loads()
+            )
+
+        return {
+            "status": "success",
+            "footprint_mb": request.footprint_mb,
+            "group": request.group,
+            "message": f"Cache footprint set to {request.footprint_mb} MiB",
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+
+@app.get("/api/cache-footprint")
+async def get_cache_footprint():
+    """Get the cache footprint of the cache kernel threads and its LLC bound."""
+    return cpu_loader.get_cache_footprint()
+
+
+@app.put("/api/threads/{thread_id}/ops-target")
+async def set_thread_ops_target(thread_id: int, request: OpsTargetRequest):
+    """Set a throughput target (ops per second) for a specific thread."""
+    try:
+        cpu_loader.set_thread_ops_target(thread_id, request.ops_per_sec)
+        return {
+            "status": "success",
+            "thread_id": thread_id,
+            "ops_per_sec": request.ops_per_sec,
+            "message": f"Thread {thread_id} ops target set to {request.ops_per_sec}/s",
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+
+@app.post("/api/threads/ops-target/all")
+async def set_all_ops_targets(request: OpsTargetRequest):
+    """Set the same throughput target for all threads."""
+    try:
+        cpu_loader.set_all_ops_targets(request.ops_per_sec)
+        return {
+            "status": "success",
+            "ops_per_sec": request.ops_per_sec,
+            "num_threads": cpu_loader.get_num_threads(),
+            "message": f"All threads set to {request.ops_per_sec} ops/s",
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+
+@app.get("/api/groups")
+async def get_groups():
+    """Get the defined worker groups with their threads and loads."""
+    loads = cpu_loader.get_all_loads()
+    return {
+        name: {
+            "threads": thread_ids,
+            "loads": {thread_id: loads[thread_id] for thread_id in thread_ids},
+        }
+        for name, thread_ids in cpu_loader.get_groups().items()
+    }
+
+
+@app.put("/api/groups")
+async def define_groups(request: GroupsDefinitionRequest):
+    """Replace all threads with named groups of threads."""
+    try:
+        cpu_loader.define_groups(request.groups)
+
+        # Publish updated settings to MQTT
+        if mqtt_publisher:
+            mqtt_publisher.publish_load_settings(
+                cpu_loader.get_num_threads(), cpu_loader.get_all_loads()
+            )
+
+        return {
+            "status": "success",
+            "groups": cpu_loader.get_groups(),
+            "num_threads": cpu_loader.get_num_threads(),
+            "message": f"Defined {len(request.groups)} groups",
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+
+@app.put("/api/groups/{name}")
+async def set_group_settings(name: str, request: GroupSettingsRequest):
+    """Set load, kernel, placement, priority and waveform of a group."""
+    try:
+        waveform = request.waveform
+        cpu_loader.set_group_settings(
+            name,
+            load_percent=request.load_percent,
+            ops_per_sec=request.ops_per_sec,
+            computation_type=request.computation_type,
+            cpus=request.cpus,
+            nice=request.nice,
+            waveform=waveform.shape if waveform else None,
+            period_ms=waveform.period_ms if waveform else 1000.0,
+            amplitude_percent=waveform.amplitude_percent if waveform else 0.0,
+        )
+
+        # Publish updated settings to MQTT
+        if mqtt_publisher:
+            mqtt_publisher.publish_load_settings(
+                cpu_loader.get_num_threads(), cpu_loader.get_all_loads()
+            )
+
+        return {
+            "status": "success",
+            "group": name,
+            "settings": request.model_dump(exclude_none=True),
+            "message": f"Group {name} updated",
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+    except NotImplementedError as e:
+        raise HTTPException(status_code=501, detail=str(e))
+    except OSError as e:
+        raise HTTPException(status_code=403, detail=str(e))
+
+
+@app.get("/api/control")
+async def get_control_status():
+    """Get the active closed-loop control mode."""
+    status = cpu_loader.get_controller_status()
+    return status if status is not None else {"mode": "none"}
+
+
+@app.delete("/api/control")
+async def stop_control():
+    """Stop closed-loop control, keeping the last applied loads."""
+    cpu_loader.stop_controller()
+    return {"status": "success", "message": "Closed-loop control stopped"}
+
+
+@app.put("/api/control/shadow")
+async def start_shadow_control(request: ShadowControlRequest):
+    """Mirror the CPU usage of another process or cgroup."""
+    try:
+        controller = ShadowController(
+            cpu_loader,
+            pid=request.pid,
+            cgroup=request.cgroup,
+            shadow_mode=request.mode,
+            factor=request.factor,
+            capacity=request.capacity,
+            interval=request.interval_ms / 1000.0,
+            distribution=request.distribution,
+            subtract_overhead=request.subtract_overhead,
+        )
+    except (ValueError, OSError) as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    cpu_loader.start_controller(controller)
+    return {
+        "status": "success",
+        "control": controller.status(),
+        "message": f"Shadowing {request.pid or request.cgroup} ({request.mode})",
+    }
+
+
+@app.put("/api/control/host-target")
+async def start_host_target_control(request: HostTargetControlRequest):
+    """Hold total host CPU utilization at a target, filling the headroom."""
+    try:
+        controller = HostTargetController(
+            cpu_loader,
+            target_percent=request.target_percent,
+            gain=request.gain,
+            interval=request.interval_ms / 1000.0,
+            distribution=request.distribution,
+        )
+    except (ValueError, OSError) as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    cpu_loader.start_controller(controller)
+    return {
+        "status": "success",
+        "control": controller.status(),
+        "message": f"Holding host CPU at {request.target_percent}%",
+    }
+
+
+@app.put("/api/control/psi")
+async def start_pressure_control(request: PressureControlRequest):
+    """Hold CPU pressure stall ('some') at a target percentage."""
+    try:
+        controller = PressureController(
+            cpu_loader,
+            target_percent=request.target_percent,
+            cgroup=request.cgroup,
+            gain=request.gain,
+            interval=request.interval_ms / 1000.0,
+            distribution=request.distribution,
+        )
+    except (ValueError, OSError) as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    cpu_loader.start_controller(controller)
+    return {
+        "status": "success",
+        "control": controller.status(),
+        "message": f"Holding CPU pressure at {request.target_percent}%",
+    }
+
+
+@app.put("/api/control/thermal")
+async def start_thermal_control(request: ThermalControlRequest):
+    """Hold the CPU package temperature at a set point."""
+    if not temperature_monitoring_enabled:
+        raise HTTPException(
+            status_code=400, detail="Temperature monitoring is disabled"
+        )
+
+    try:
+        controller = ThermalController(
+            cpu_loader,
+            target_celsius=request.target_celsius,
+            ceiling_celsius=request.ceiling_celsius,
+            kp=request.kp,
+            ki=request.ki,
+            kd=request.kd,
+            max_rate=request.max_rate,
+            interval=request.interval_ms / 1000.0,
+            distribution=request.distribution,
+        )
+    except (ValueError, OSError) as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    cpu_loader.start_controller(controller)
+    return {
+        "status": "success",
+        "control": controller.status(),
+        "message": f"Holding CPU temperature at {request.target_celsius} C",
+    }
+
+
+@app.put("/api/control/power")
+async def start_power_control(request: PowerControlRequest):
+    """Hold package power at a target wattage using powercap counters."""
+    try:
+        kernels = [ComputationType.from_string(k) for k in request.kernels or []]
+        controller = PowerController(
+            cpu_loader,
+            target_watts=request.target_watts,
+            kernels=kernels,
+            gain=request.gain,
+            interval=request.interval_ms / 1000.0,
+            distribution=request.distribution,
+        )
+    except (ValueError, OSError) as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    cpu_loader.start_controller(controller)
+    return {
+        "status": "success",
+        "control": controller.status(),
+        "message": f"Holding package power at {request.target_watts} W",
+    }
+
+
+@app.put("/api/control/memory-bandwidth")
+async def start_bandwidth_control(request: BandwidthControlRequest):
+    """Hold an aggregate memory bandwidth with streaming-kernel workers."""
+    try:
+        controller = MemoryBandwidthController(
+            cpu_loader,
+            target_gbps=request.target_gbps,
+            gain=request.gain,
+            interval=request.interval_ms / 1000.0,
+            distribution=request.distribution,
+        )
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    cpu_loader.start_controller(controller)
+    return {
+        "status": "success",
+        "control": controller.status(),
+        "message": f"Holding memory bandwidth at {request.target_gbps} GB/s",
+    }
+
+
+@app.put("/api/control/yield")
+async def start_yield_control(request: YieldControlRequest):
+    """Harvest spare CPU and back off when a protected victim waits for a CPU."""
+    try:
+        controller = YieldController(
+            cpu_loader,
+            pid=request.pid,
+            cgroup=request.cgroup,
+            threshold_us=request.threshold_us,
+            resume_us=request.resume_us,
+            increase=request.increase,
+            decrease=request.decrease,
+            max_cores=request.max_cores,
+            interval=request.interval_ms / 1000.0,
+            distribution=request.distribution,
+        )
+    except (ValueError, OSError) as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    cpu_loader.start_controller(controller)
+    target = f"PID {request.pid}" if request.pid else f"cgroup {request.cgroup}"
+    return {
+        "status": "success",
+        "control": controller.status(),
+        "message": f"Yielding to {target} above {request.threshold_us} us delay",
+    }
+
+
+@app.get("/api/victim")
+async def get_victim_status():
+    """Get the victim's latency summary next to the current load settings."""
+    return {
+        "victim": cpu_loader.get_victim_status(),
+        "loads": cpu_loader.get_all_loads(),
+        "computation_type": cpu_loader.get_computation_type_string(),
+    }
+
+
+@app.put("/api/victim")
+async def start_victim(request: VictimRequest):
+    """Start a latency-measuring victim workload."""
+    kwargs = {"rate": request.rate}
+    if request.work_us is not None:
+        kwargs["work_us"] = request.work_us
+    if request.mode == "echo":
+        kwargs["payload_bytes"] = request.payload_bytes
+
+    try:
+        victim = create_victim(request.mode, **kwargs)
+        cpu_loader.start_victim(victim)
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+    except OSError as e:
+        raise HTTPException(status_code=500, detail=str(e))
+
+    return {
+        "status": "success",
+        "victim": victim.status(),
+        "message": f"{request.mode} victim started at {request.rate} requests/s",
+    }
+
+
+@app.delete("/api/victim")
+async def stop_victim():
+    """Stop the victim workload."""
+    cpu_loader.stop_victim()
+    return {"status": "success", "message": "Victim stopped"}
+
+
+@app.post("/api/victim/reset")
+async def reset_victim():
+    """Discard the victim's recorded latencies."""
+    if cpu_loader.victim is None:
+        raise HTTPException(status_code=400, detail="No victim is running")
+
+    cpu_loader.victim.histogram.reset()
+    return {"status": "success", "message": "Victim latencies reset"}
+
+
+@app.post("/api/victim/sweep")
+async def run_victim_sweep(request: VictimSweepRequest):
+    """Measure the victim's latency at a series of load levels."""
+    if cpu_loader.victim is None:
+        raise HTTPException(status_code=400, detail="No victim is running")
+
+    try:
+        results = await asyncio.to_thread(
+            run_sweep,
+            cpu_loader,
+            cpu_loader.victim,
+            request.levels,
+            request.duration_s,
+            request.settle_s,
+            request.computation_type,
+        )
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    return {
+        "status": "success",
+        "results": results,
+        "message": f"Measured {len(results)} load levels",
+    }
+
+
+@app.get("/api/ready")
+async def get_ready():
+    """Check whether the loader is warmed up and ready for measurements."""
+    return {"ready": cpu_loader.is_ready(), "warmup": cpu_loader.warmup_report}
+
+
+@app.post("/api/warmup")
+async def start_warmup(request: WarmupRequest):
+    """Prefault buffers and run kernels until their throughput is stable."""
+    global warmup_task
+    # Checked and started without awaiting in between, so that concurrent
+    # requests cannot both start one
+    if warmup_task is not None and not warmup_task.done():
+        raise HTTPException(status_code=409, detail="A warm-up is already running")
+
+    warmup_task = asyncio.create_task(
+        run_warmup(
+            kernels=request.kernels,
+            max_seconds=request.max_seconds,
+            cv_threshold=request.cv_percent / 100.0,
+            cache=calibration_cache,
+        )
+    )
+    try:
+        # A client disconnect must not orphan the warm-up thread
+        report = await asyncio.shield(warmup_task)
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+    return {
+        "status": "success",
+        "ready": cpu_loader.is_ready(),
+        "warmup": report,
+        "message": f"Warm-up finished in {report['seconds']} s",
+    }
+
+
 @app.get("/api/computation-type", response_model=ComputationTypeResponse)
 async def get_computation_type():
     """Get the current computation type."""
     current_type = cpu_loader.get_computation_type_string()
-    available_types = ["busy-wait", "pi", "primes", "matrix", "fibonacci"]
+    available_types = [
+        "busy-wait",
+        "pi",
+        "primes",
+        "matrix",
+        "fibonacci",
+        "stream",
+        "cache",
+    ]
     return ComputationTypeResponse(
         computation_type=current_type, available_types=available_types
     )
@@ -349,10 +1199,49 @@ async def set_computation_type(request: ComputationTypeRequest):
         raise HTTPException(status_code=400, detail=str(e))
 
 
+@app.get("/api/phase-stagger")
+async def get_phase_stagger():
+    """Get whether worker cycle phases are staggered."""
+    return {"enabled": cpu_loader.get_phase_stagger()}
+
+
+@app.put("/api/phase-stagger")
+async def set_phase_stagger(request: PhaseStaggerRequest):
+    """Enable or disable phase-staggered worker cycles."""
+    cpu_loader.set_phase_stagger(request.enabled)
+    state = "enabled" if request.enabled else "disabled"
+    return {
+        "status": "success",
+        "enabled": request.enabled,
+        "message": f"Phase staggering {state}",
+    }
+
+
+@app.get("/api/cycle-time")
+async def get_cycle_time():
+    """Get the duty cycle period of the worker threads."""
+    return {"cycle_ms": cpu_loader.get_cycle_time()}
+
+
+@app.put("/api/cycle-time")
+async def set_cycle_time(request: CycleTimeRequest):
+    """Set the duty cycle period of the worker threads."""
+    try:
+        cpu_loader.set_cycle_time(request.cycle_ms)
+        return {
+            "status": "success",
+            "cycle_ms": request.cycle_ms,
+            "message": f"Cycle time set to {request.cycle_ms} ms",
+        }
+    except ValueError as e:
+        raise HTTPException(status_code=400, detail=str(e))
+
+
 def parse_args():
     """Parse command-line arguments."""
     parser = argparse.ArgumentParser(
-        description="CPU Loader - Generate controllable CPU load with REST API and WebUI"
+        description="CPU Loader - Generate controllable CPU load with REST API and WebUI",
+        epilog="Run 'cpu-loader bench --help' for the kernel benchmark suite.",
     )
     parser.add_argument(
         "--host",
@@ -372,10 +1261,44 @@ def parse_args():
     )
     parser.add_argument(
         "--computation-type",
-        choices=["busy-wait", "pi", "primes", "matrix", "fibonacci"],
+        choices=["busy-wait", "pi", "primes", "matrix", "fibonacci", "stream", "cache"],
         default="busy-wait",
         help="Type of computation to perform during CPU load generation (default: busy-wait)",
     )
+    parser.add_argument(
+        "--stagger-phases",
+        action="store_true",
+        help="Spread worker cycle phases evenly for a flat aggregate load",
+    )
+    parser.add_argument(
+        "--cycle-time",
+        type=float,
+        metavar="MS",
+        help="Duty cycle period of the worker threads in ms, 1-100 (default: 10)",
+    )
+    parser.add_argument(
+        "--host-target",
+        type=float,
+        metavar="PERCENT",
+        help="Keep total host CPU utilization at PERCENT by filling the headroom",
+    )
+    parser.add_argument(
+        "--warmup",
+        type=float,
+        metavar="SECONDS",
+        help="Warm up for at most SECONDS before reporting ready (GET /api/ready)",
+    )
+    parser.add_argument(
+        "--calibration-cache",
+        metavar="FILE",
+        default=str(DEFAULT_CACHE_PATH),
+        help=f"Cache of warm-up results (default: {DEFAULT_CACHE_PATH})",
+    )
+    parser.add_argument(
+        "--no-calibration-cache",
+        action="store_true",
+        help="Always run warm-ups to completion, without reading or writing the cache",
+    )
 
     # MQTT arguments
     mqtt_group = parser.add_argument_group("MQTT settings")
@@ -434,6 +1357,13 @@ def run():
     # Store MQTT args and computation type in app state for lifespan to access
     app.state.mqtt_args = mqtt_args
     app.state.computation_type = args.computation_type
+    app.state.stagger_phases = args.stagger_phases
+    app.state.cycle_ms = args.cycle_time
+    app.state.host_target = args.host_target
+    app.state.warmup = args.warmup
+    app.state.calibration_cache = (
+        None if args.no_calibration_cache else args.calibration_cache
+    )
 
     # Run the server
     uvicorn.run(app, host=args.host, port=args.port)
@@ -1,12 +1,13 @@
 """
 MQTT Publisher Module
-Publishes CPU load control settings and metrics to MQTT broker.
+Publishes CPU load control settings and metrics to MQTT broker and receives
+load commands from it.
 """
 
 import json
 import logging
 import os
-from typing import Dict, Optional
+from typing import Any, Callable, Dict, Optional
 
 try:
     import paho.mqtt.client as mqtt
@@ -27,6 +28,7 @@ class MQTTPublisher:
         password: Optional[str] = None,
         topic_prefix: Optional[str] = None,
         client_id: Optional[str] = None,
+        command_handler: Optional[Callable[[Dict], Any]] = None,
     ):
         """
         Initialize MQTT publisher.
@@ -38,6 +40,8 @@ class MQTTPublisher:
             password: MQTT password (env: MQTT_PASSWORD)
             topic_prefix: Topic prefix (env: MQTT_TOPIC_PREFIX, default: cpu-loader)
             client_id: MQTT client ID (env: MQTT_CLIENT_ID, default: cpu-loader)
+            command_handler: Called with the decoded JSON payload of every
+                             message on {prefix}/set/load (optional)
         """
         if mqtt is None:
             raise ImportError(
@@ -53,9 +57,12 @@ class MQTTPublisher:
         self.password = password or os.getenv("MQTT_PASSWORD")
         self.topic_prefix = topic_prefix or os.getenv("MQTT_TOPIC_PREFIX", "cpu-loader")
         self.client_id = client_id or os.getenv("MQTT_CLIENT_ID", "cpu-loader")
+        self.command_handler = command_handler
 
         self.client: Optional[mqtt.Client] = None
         self.connected = False
+        # Last ready state, republished on every connect (see publish_ready)
+        self._ready_payload: Optional[Dict[str, Any]] = None
 
         # Only connect if broker host is provided
         if self.broker_host:
@@ -75,6 +82,7 @@ class MQTTPublisher:
             # Set callbacks
             self.client.on_connect = self._on_connect
             self.client.on_disconnect = self._on_disconnect
+            self.client.on_message = self._on_message
 
             # Set credentials if provided
             if self.username:
@@ -98,6 +106,14 @@ class MQTTPublisher:
         if rc == 0:
             self.connected = True
             logger.info("Connected to MQTT broker")
+
+            # Subscribe on every connect so commands survive reconnects
+            if self.command_handler:
+                client.subscribe(f"{self.topic_prefix}/set/load", qos=1)
+
+            # The ready state set before the connection came up would be lost
+            if self._ready_payload is not None:
+                self._publish_ready()
         else:
             self.connected = False
             logger.error(f"Failed to connect to MQTT broker with code: {rc}")
@@ -110,6 +126,16 @@ class MQTTPublisher:
         else:
             logger.info("Disconnected from MQTT broker")
 
+    def _on_message(self, client, userdata, message):
+        """Callback for load commands, runs in the MQTT network thread."""
+        try:
+            command = json.loads(message.payload)
+            if not isinstance(command, dict):
+                raise ValueError("Command must be a JSON object")
+            self.command_handler(command)
+        except Exception as e:
+            logger.error(f"Invalid MQTT command on {message.topic}: {e}")
+
     def publish_load_settings(self, num_threads: int, loads: Dict[int, float]):
         """
         Publish load control settings to MQTT.
@@ -150,6 +176,8 @@ class MQTTPublisher:
         total_cpu_percent: float,
         per_cpu_percent: list,
         cpu_temperature: Optional[float] = None,
+        pressure: Optional[Dict[str, Dict[str, float]]] = None,
+        overhead: Optional[Dict] = None,
     ):
         """
         Publish CPU metrics to MQTT.
@@ -158,6 +186,8 @@ class MQTTPublisher:
             total_cpu_percent: Total CPU utilization percentage
             per_cpu_percent: List of per-CPU utilization percentages
             cpu_temperature: CPU temperature in Celsius (optional)
+            pressure: PSI 10s averages per resource (optional)
+            overhead: CPU usage of the loader's control plane (optional)
         """
         if not self.connected or not self.client:
             return
@@ -173,6 +203,14 @@ class MQTTPublisher:
             if cpu_temperature is not None:
                 payload["cpu_temperature"] = cpu_temperature
 
+            # Add pressure stall information if available
+            if pressure is not None:
+                payload["pressure"] = pressure
+
+            # Add the loader's self-overhead if measured
+            if overhead is not None:
+                payload["overhead"] = overhead
+
             # Publish to topic
             topic = f"{self.topic_prefix}/cpu_metrics"
             self.client.publish(
@@ -186,6 +224,40 @@ class MQTTPublisher:
         except Exception as e:
             logger.error(f"Failed to publish CPU metrics: {e}")
 
+    def publish_ready(self, ready: bool, warmup: Optional[Dict] = None):
+        """
+        Publish whether the loader is ready for measurements.
+
+        The state is kept and published again whenever the connection to the
+        broker is (re)established, as the client connects asynchronously and
+        the first states are set before it is connected.
+
+        Args:
+            ready: False while a warm-up is running
+            warmup: Report of the finished warm-up (optional)
+        """
+        self._ready_payload = {"ready": ready, "warmup": warmup}
+        self._publish_ready()
+
+    def _publish_ready(self):
+        """Publish the last ready state if connected."""
+        if not self.connected or not self.client:
+            return
+
+        try:
+            # Retained so that late subscribers see the current state
+            topic = f"{self.topic_prefix}/ready"
+            self.client.publish(
+                topic,
+                json.dumps(self._ready_payload),
+                qos=1,
+                retain=True,
+            )
+            logger.debug(f"Published ready state to {topic}")
+
+        except Exception as e:
+            logger.error(f"Failed to publish ready state: {e}")
+
     def disconnect(self):
         """Disconnect from MQTT broker."""
         if self.client:
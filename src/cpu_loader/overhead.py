@@ -0,0 +1,119 @@
+"""
+Self-Overhead Module
+Measures the CPU time the loader's own control plane (event loop, MQTT
+client, controllers, samplers) consumes next to the deliberate load of its
+worker threads.
+"""
+
+import os
+import threading
+import time
+from pathlib import Path
+from typing import Any, Dict, Optional
+
+from cpu_loader import sensors
+
+
+def thread_labels(pid: Optional[int] = None) -> Dict[int, str]:
+    """
+    Name the threads of a process.
+
+    Threads started from Python are named after their threading.Thread name,
+    all others after their kernel name (/proc/<pid>/task/<tid>/comm).
+
+    Args:
+        pid: Process whose threads are named (default: this process)
+
+    Returns:
+        Dictionary mapping thread ID to label
+    """
+    pid = os.getpid() if pid is None else pid
+    labels = {}
+    for tid in os.listdir(f"/proc/{pid}/task"):
+        try:
+            labels[int(tid)] = Path(f"/proc/{pid}/task/{tid}/comm").read_text().strip()
+        except OSError:
+            continue
+
+    if pid == os.getpid():
+        for thread in threading.enumerate():
+            if thread.native_id in labels:
+                labels[thread.native_id] = thread.name
+    return labels
+
+
+class OverheadMeter:
+    """
+    Splits the process's CPU usage into the workers' deliberate load and the
+    overhead of every other thread, per sample interval.
+
+    Threads that started since the previous sample are counted with all of
+    their CPU time, threads that exited in between are lost.
+    """
+
+    def __init__(self, loader):
+        """
+        Initialize the meter and take the first sample.
+
+        Args:
+            loader: CPULoader whose worker threads are the deliberate load
+
+        Raises:
+            OSError: If the host has no per-thread scheduler statistics
+                     (no /proc, e.g. macOS)
+        """
+        self.loader = loader
+        self.last: Optional[Dict[str, Any]] = None
+        self._last_run_ns = sensors.read_task_schedstats(os.getpid())
+        if not self._last_run_ns:
+            raise OSError("No per-thread scheduler statistics in /proc")
+        self._last_time = time.monotonic()
+
+    def sample(self) -> Dict[str, Any]:
+        """
+        Measure the CPU usage since the previous sample.
+
+        Returns:
+            Dictionary with the sample interval in seconds, the cores used by
+            the worker threads and by everything else (overhead), the
+            overhead as a percentage of the process's total, and the
+            overhead cores per thread label, largest first
+        """
+        run_ns = sensors.read_task_schedstats(os.getpid())
+        now = time.monotonic()
+        worker_tids = {s["tid"] for s in self.loader.get_all_stats().values()}
+        labels = thread_labels()
+
+        elapsed = now - self._last_time
+        worker_ns = 0
+        overhead_ns = 0
+        per_label: Dict[str, int] = {}
+        for tid, (ns, _, _) in run_ns.items():
+            previous = self._last_run_ns.get(tid)
+            delta = ns - previous[0] if previous is not None else ns
+            if tid in worker_tids:
+                worker_ns += delta
+            else:
+                overhead_ns += delta
+                label = labels.get(tid, str(tid))
+                per_label[label] = per_label.get(label, 0) + delta
+        self._last_run_ns = run_ns
+        self._last_time = now
+
+        def cores(ns: int) -> float:
+            return round(ns / 1e9 / elapsed, 4) if elapsed > 0 else 0.0
+
+        total_ns = worker_ns + overhead_ns
+        self.last = {
+            "interval_s": round(elapsed, 3),
+            "worker_cores": cores(worker_ns),
+            "overhead_cores": cores(overhead_ns),
+            "overhead_percent": (
+                round(overhead_ns / total_ns * 100.0, 2) if total_ns else 0.0
+            ),
+            "threads": {
+                label: cores(ns)
+                for label, ns in sorted(per_label.items(), key=lambda i: -i[1])
+            },
+        }
+        return self.last
@@ -0,0 +1,193 @@
+"""
+Scalability Model Module
+Fits Amdahl's law and the Universal Scalability Law (USL) to throughput
+measured at different thread counts.
+
+Both models describe the relative capacity C(N) = X(N) / X(1):
+
+    Amdahl: C(N) = N / (1 + sigma * (N - 1))
+    USL:    C(N) = N / (1 + sigma * (N - 1) + kappa * N * (N - 1))
+
+sigma is the contention (serial fraction) and kappa the coherency
+(crosstalk) coefficient. With kappa > 0 throughput peaks at the knee
+N* = sqrt((1 - sigma) / kappa) and declines beyond it.
+"""
+
+import math
+from typing import Any, Dict, List, Optional, Sequence, Tuple
+
+KAPPA_DIGITS = 7
+KAPPA_PRECISION = 10**-KAPPA_DIGITS
+
+
+def _relative_capacity(points: Sequence[Tuple[int, float]]) -> List[Tuple[int, float]]:
+    """Normalize (threads, throughput) points to the single-thread throughput."""
+    base = next((x for n, x in points if n == 1), None)
+    if not base:
+        raise ValueError("A single-thread measurement is required")
+
+    return [(n, x / base) for n, x in points if n > 1 and x > 0]
+
+
+def _r_squared(
+    capacity: Sequence[Tuple[int, float]], sigma: float, kappa: float
+) -> Optional[float]:
+    """Coefficient of determination of a model fit on the capacity points."""
+    if len(capacity) < 2:
+        return None
+
+    mean = sum(c for _, c in capacity) / len(capacity)
+    total = sum((c - mean) ** 2 for _, c in capacity)
+    residual = sum((c - usl_capacity(n, sigma, kappa)) ** 2 for n, c in capacity)
+    return 1.0 - residual / total if total > 0 else None
+
+
+def usl_capacity(n: float, sigma: float, kappa: float = 0.0) -> float:
+    """Relative capacity at n threads (Amdahl's law for kappa = 0)."""
+    return n / (1.0 + sigma * (n - 1) + kappa * n * (n - 1))
+
+
+def fit_amdahl(points: Sequence[Tuple[int, float]]) -> Dict[str, Any]:
+    """
+    Fit Amdahl's law by least squares.
+
+    N / C(N) - 1 = sigma * (N - 1) is linear in sigma, so the fit is a
+    regression through the origin.
+
+    Args:
+        points: (threads, throughput) measurements including one thread
+
+    Returns:
+        Dictionary with sigma, the asymptotic speedup 1 / sigma (None if
+        unbounded) and r_squared
+    """
+    capacity = _relative_capacity(points)
+    if not capacity:
+        raise ValueError("Measurements at more than one thread are required")
+
+    sxx = sum((n - 1) ** 2 for n, _ in capacity)
+    sxy = sum((n - 1) * (n / c - 1) for n, c in capacity)
+    sigma = min(max(sxy / sxx, 0.0), 1.0)
+
+    return {
+        "sigma": round(sigma, 5),
+        "max_speedup": round(1.0 / sigma, 2) if sigma > 0 else None,
+        "r_squared": _round(_r_squared(capacity, sigma, 0.0)),
+    }
+
+
+def fit_usl(points: Sequence[Tuple[int, float]]) -> Dict[str, Any]:
+    """
+    Fit the Universal Scalability Law by least squares.
+
+    N / C(N) - 1 = sigma * (N - 1) + kappa * N * (N - 1) is linear in sigma
+    and kappa. Both are constrained to be non-negative: if the unconstrained
+    solution violates that, the coefficient is fixed at 0 and the other one
+    refitted.
+
+    Args:
+        points: (threads, throughput) measurements including one thread
+
+    Returns:
+        Dictionary with sigma, kappa, the knee point (threads at peak
+        throughput, None without coherency cost), the relative capacity at
+        the knee and r_squared
+    """
+    capacity = _relative_capacity(points)
+    if len({n for n, _ in capacity}) < 2:
+        raise ValueError("Measurements at two thread counts above one are required")
+
+    # Normal equations for y = sigma * a + kappa * b
+    rows = [(n - 1, n * (n - 1), n / c - 1) for n, c in capacity]
+    saa = sum(a * a for a, _, _ in rows)
+    sbb = sum(b * b for _, b, _ in rows)
+    sab = sum(a * b for a, b, _ in rows)
+    say = sum(a * y for a, _, y in rows)
+    sby = sum(b * y for _, b, y in rows)
+
+    det = saa * sbb - sab * sab
+    sigma = (say * sbb - sby * sab) / det if det else say / saa
+    kappa = (saa * sby - sab * say) / det if det else 0.0
+
+    # Coefficients below the reported precision are rounding noise
+    if kappa < KAPPA_PRECISION:
+        kappa = 0.0
+        sigma = say / saa
+    if sigma < 0:
+        sigma = 0.0
+        kappa = max(sby / sbb, 0.0)
+    sigma = min(sigma, 1.0)
+
+    knee = peak = None
+    if kappa > 0:
+        knee = math.sqrt((1.0 - sigma) / kappa)
+        peak = usl_capacity(knee, sigma, kappa)
+
+    return {
+        "sigma": round(sigma, 5),
+        "kappa": round(kappa, KAPPA_DIGITS),
+        "knee_threads": round(knee, 1) if knee is not None else None,
+        "peak_capacity": round(peak, 2) if peak is not None else None,
+        "r_squared": _round(_r_squared(capacity, sigma, kappa)),
+    }
+
+
+def fit_results(results: Sequence[Dict[str, Any]]) -> Dict[str, Dict[str, Any]]:
+    """
+    Fit both models for every kernel of a benchmark run.
+
+    Args:
+        results: Benchmark results with kernel, threads and ops_per_sec
+
+    Returns:
+        Dictionary mapping kernel name to its 'amdahl' and 'usl' fits. A fit
+        that is not possible holds an 'error' entry instead.
+    """
+    points: Dict[str, List[Tuple[int, float]]] = {}
+    for result in results:
+        points.setdefault(result["kernel"], []).append(
+            (result["threads"], result["ops_per_sec"])
+        )
+
+    fits = {}
+    for kernel, kernel_points in points.items():
+        fits[kernel] = {}
+        for model, fit in (("amdahl", fit_amdahl), ("usl", fit_usl)):
+            try:
+                fits[kernel][model] = fit(kernel_points)
+            except ValueError as e:
+                fits[kernel][model] = {"error": str(e)}
+
+    return fits
+
+
+def format_fit_table(fits: Dict[str, Dict[str, Any]]) -> str:
+    """Format scalability fits as one line per kernel."""
+    header = (
+        f"{'kernel':<10} {'amdahl':>9} {'max x':>7} {'usl':>8} "
+        f"{'usl':>10} {'knee':>8} {'peak x':>7} {'usl':>6}\n"
+        f"{'':<10} {'sigma':>9} {'':>7} {'sigma':>8} "
+        f"{'kappa':>10} {'N*':>8} {'':>7} {'R^2':>6}"
+    )
+    lines = [header, "-" * len(header.splitlines()[0])]
+    for kernel, fit in fits.items():
+        amdahl = fit["amdahl"]
+        usl = fit["usl"]
+        lines.append(
+            f"{kernel:<10} {_cell(amdahl, 'sigma'):>9} "
+            f"{_cell(amdahl, 'max_speedup'):>7} {_cell(usl, 'sigma'):>8} "
+            f"{_cell(usl, 'kappa'):>10} {_cell(usl, 'knee_threads'):>8} "
+            f"{_cell(usl, 'peak_capacity'):>7} {_cell(usl, 'r_squared'):>6}"
+        )
+    return "\n".join(lines)
+
+
+def _cell(fit: Dict[str, Any], key: str) -> str:
+    """Table cell for a fit value, '-' if missing or not applicable."""
+    value = fit.get(key)
+    return "-" if value is None else str(value)
+
+
+def _round(value: Optional[float]) -> Optional[float]:
+    """Round a fit statistic that may be missing."""
+    return round(value, 4) if value is not None else None
@@ -0,0 +1,493 @@
+"""
+Sensors Module
+Reads CPU accounting, pressure stall information, temperature and energy
+of the host, processes and cgroups from procfs, sysfs, cgroupfs and psutil.
+"""
+
+import os
+import platform
+import re
+import time
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Tuple
+
+import psutil
+
+CGROUP_ROOT = Path("/sys/fs/cgroup")
+POWERCAP_ROOT = Path("/sys/class/powercap")
+PRESSURE_ROOT = Path("/proc/pressure")
+PRESSURE_RESOURCES = ("cpu", "memory", "io")
+CPU_CACHE_ROOT = Path("/sys/devices/system/cpu/cpu0/cache")
+CPUFREQ_ROOT = Path("/sys/devices/system/cpu/cpu0/cpufreq")
+SMT_ROOT = Path("/sys/devices/system/cpu/smt")
+CLOCK_TICKS = os.sysconf("SC_CLK_TCK") if hasattr(os, "sysconf") else 100
+
+# Common temperature sensor names to check, in order of preference
+TEMPERATURE_SENSORS = ["coretemp", "cpu_thermal", "acpi", "k8temp", "k10temp"]
+TEMPERATURE_CACHE_SECONDS = 0.5
+
+# Last temperature reading as (monotonic time, value)
+_temperature_cache: Tuple[float, Optional[float]] = (float("-inf"), None)
+
+
+def read_cpu_temperature(
+    max_age: float = TEMPERATURE_CACHE_SECONDS,
+) -> Optional[float]:
+    """
+    Get the CPU package temperature.
+
+    Enumerating hwmon sensors is slow, so readings are cached and shared by
+    the metrics loop and the thermal controller.
+
+    Args:
+        max_age: Maximum age in seconds of a cached reading
+
+    Returns:
+        Temperature in Celsius, or None if no sensor is available
+    """
+    global _temperature_cache
+
+    timestamp, value = _temperature_cache
+    now = time.monotonic()
+    if now - timestamp <= max_age:
+        return value
+
+    value = None
+    try:
+        temperatures = psutil.sensors_temperatures()
+
+        for temp_name in TEMPERATURE_SENSORS:
+            if temperatures.get(temp_name):
+                # Get the first temperature reading
+                value = round(temperatures[temp_name][0].current, 1)
+                break
+        else:
+            # If no specific sensor found, try the first available
+            for temp_list in temperatures.values():
+                if temp_list:
+                    value = round(temp_list[0].current, 1)
+                    break
+
+    except (AttributeError, OSError):
+        # Temperature monitoring not available on this system
+        pass
+
+    _temperature_cache = (now, value)
+    return value
+
+
+def read_llc_bytes() -> Optional[int]:
+    """
+    Read the size of the last-level cache seen by CPU 0.
+
+    Returns:
+        Size in bytes of the highest-level data or unified cache, or None if
+        sysfs does not describe the caches
+    """
+    best_level = 0
+    best_size = None
+    for index in sorted(CPU_CACHE_ROOT.glob("index*")):
+        try:
+            if (index / "type").read_text().strip() == "Instruction":
+                continue
+            level = int((index / "level").read_text())
+            size = (index / "size").read_text().strip()
+        except (OSError, ValueError):
+            continue
+
+        # Sizes are given as e.g. '32K' or '16384K'
+        multiplier = {"K": 1024, "M": 1024 * 1024}.get(size[-1:].upper(), 1)
+        try:
+            size_bytes = int(size.rstrip("KkMm")) * multiplier
+        except ValueError:
+            continue
+
+        if level > best_level:
+            best_level = level
+            best_size = size_bytes
+
+    return best_size
+
+
+def read_reference_frequency() -> Optional[float]:
+    """
+    Find the nominal (non-turbo) core frequency.
+
+    Tries the cpufreq base_frequency, the rated frequency in the CPU model
+    name (e.g. '@ 2.40GHz'), the cpufreq maximum and finally the 'cpu MHz'
+    the kernel reports in /proc/cpuinfo.
+
+    Returns:
+        Frequency in Hz, or None if it cannot be determined
+    """
+    try:
+        return int((CPUFREQ_ROOT / "base_frequency").read_text()) * 1e3
+    except (OSError, ValueError):
+        pass
+
+    try:
+        cpuinfo = Path("/proc/cpuinfo").read_text()
+    except OSError:
+        cpuinfo = ""
+
+    match = re.search(r"^model name\s*:.*@\s*([\d.]+)\s*GHz", cpuinfo, re.MULTILINE)
+    if match:
+        return float(match.group(1)) * 1e9
+
+    try:
+        return int((CPUFREQ_ROOT / "cpuinfo_max_freq").read_text()) * 1e3
+    except (OSError, ValueError):
+        pass
+
+    match = re.search(r"^cpu MHz\s*:\s*([\d.]+)", cpuinfo, re.MULTILINE)
+    if match:
+        return float(match.group(1)) * 1e6
+
+    return None
+
+
+def read_cpu_frequency() -> Optional[float]:
+    """
+    Get the current core frequency averaged over all CPUs.
+
+    Returns:
+        Frequency in Hz, or None if the kernel does not report it
+    """
+    try:
+        frequency = psutil.cpu_freq()
+    except (AttributeError, NotImplementedError, OSError):
+        return None
+
+    if frequency is None or not frequency.current:
+        return None
+
+    return frequency.current * 1e6
+
+
+def read_host_metadata() -> Dict[str, Any]:
+    """
+    Describe the host for benchmark results.
+
+    Returns:
+        Dictionary with cpu_model and microcode from /proc/cpuinfo, the kernel
+        release, the cpufreq governor of CPU 0, the SMT control state
+        (on, off, forceoff, notsupported, ...) and whether SMT siblings are
+        active, the number of CPUs, the platform and the machine type.
+        Values that cannot be read are None.
+    """
+    try:
+        cpuinfo = Path("/proc/cpuinfo").read_text()
+    except OSError:
+        cpuinfo = ""
+
+    def cpuinfo_field(name: str) -> Optional[str]:
+        match = re.search(rf"^{name}\s*:\s*(.*)$", cpuinfo, re.MULTILINE)
+        return match.group(1).strip() if match else None
+
+    def sysfs(path: Path) -> Optional[str]:
+        try:
+            return path.read_text().strip()
+        except OSError:
+            return None
+
+    smt_active = sysfs(SMT_ROOT / "active")
+    return {
+        "cpu_model": cpuinfo_field("model name") or platform.processor() or None,
+        "microcode": cpuinfo_field("microcode"),
+        "kernel": platform.release(),
+        "governor": sysfs(CPUFREQ_ROOT / "scaling_governor"),
+        "smt": sysfs(SMT_ROOT / "control"),
+        "smt_active": smt_active == "1" if smt_active is not None else None,
+        "cpus": os.cpu_count(),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+    }
+
+
+def read_host_cpu_times() -> Tuple[int, int, int]:
+    """
+    Read the aggregate CPU times of the host from /proc/stat.
+
+    Returns:
+        Tuple of (busy, total, num_cpus), busy and total in clock ticks.
+        Busy time excludes idle and iowait.
+    """
+    num_cpus = 0
+    busy = total = 0
+    with open("/proc/stat") as f:
+        for line in f:
+            if line.startswith("cpu "):
+                # user nice system idle iowait irq softirq steal [guest ...]
+                # guest time is already included in user and nice
+                values = [int(v) for v in line.split()[1:9]]
+                total = sum(values)
+                busy = total - values[3] - values[4]
+            elif line.startswith("cpu"):
+                num_cpus += 1
+
+    return busy, total, num_cpus
+
+
+def read_process_cpu_seconds(pid: int) -> float:
+    """
+    Read the total CPU time (user + system) of a process.
+
+    Args:
+        pid: Process ID
+
+    Returns:
+        CPU seconds consumed by all threads of the process
+
+    Raises:
+        OSError: If the process does not exist or cannot be read
+    """
+    stat = Path(f"/proc/{pid}/stat").read_text()
+
+    # The command name may contain spaces and parentheses, so split after
+    # the last ')'. The remaining fields start with field 3 (state).
+    fields = stat[stat.rindex(")") + 2 :].split()
+    utime = int(fields[11])
+    stime = int(fields[12])
+    return (utime + stime) / CLOCK_TICKS
+
+
+def read_task_schedstats(
+    pid: Optional[int] = None, cgroup: Optional[str] = None
+) -> Dict[int, Tuple[int, int, int]]:
+    """
+    Read the scheduler statistics of all threads of a process or cgroup.
+
+    Each /proc/<tid>/schedstat holds the time spent on the CPU, the time
+    spent waiting on a runqueue (both in nanoseconds) and the number of
+    timeslices run. Threads that exit while being read are skipped.
+
+    Args:
+        pid: Process whose threads are read
+        cgroup: cgroup whose threads are read (see resolve_cgroup)
+
+    Returns:
+        Dictionary mapping thread ID to (run_ns, wait_ns, timeslices)
+
+    Raises:
+        OSError: If the process does not exist
+    """
+    if pid is not None:
+        tids = [int(tid) for tid in os.listdir(f"/proc/{pid}/task")]
+    else:
+        path = resolve_cgroup(cgroup)
+        threads = path / "cgroup.threads"
+        if not threads.exists():
+            # cgroup v1
+            threads = path / "tasks"
+        tids = [int(tid) for tid in threads.read_text().split()]
+
+    stats = {}
+    for tid in tids:
+        try:
+            schedstat = Path(f"/proc/{tid}/schedstat").read_text()
+            run_ns, wait_ns, timeslices = (int(v) for v in schedstat.split())
+        except (OSError, ValueError):
+            continue
+        stats[tid] = (run_ns, wait_ns, timeslices)
+
+    return stats
+
+
+def resolve_cgroup(cgroup: str) -> Path:
+    """
+    Resolve a cgroup name or path to its directory in the cgroup filesystem.
+
+    Args:
+        cgroup: Absolute path below /sys/fs/cgroup, or a path relative to it
+                (e.g. 'system.slice/nginx.service')
+
+    Returns:
+        Path of the cgroup directory
+    """
+    path = Path(cgroup)
+    if not path.is_absolute() or not str(path).startswith(str(CGROUP_ROOT)):
+        path = CGROUP_ROOT / str(cgroup).lstrip("/")
+
+    if not path.is_dir():
+        raise ValueError(f"cgroup '{cgroup}' not found")
+
+    return path
+
+
+def read_cgroup_cpu_seconds(cgroup: str) -> float:
+    """
+    Read the total CPU time consumed by a cgroup.
+
+    Uses usage_usec from cpu.stat (cgroup v2) or cpuacct.usage (cgroup v1).
+
+    Args:
+        cgroup: cgroup name or path (see resolve_cgroup)
+
+    Returns:
+        CPU seconds consumed by all tasks in the cgroup
+    """
+    path = resolve_cgroup(cgroup)
+
+    cpu_stat = path / "cpu.stat"
+    if cpu_stat.exists():
+        for line in cpu_stat.read_text().splitlines():
+            key, _, value = line.partition(" ")
+            if key == "usage_usec":
+                return int(value) / 1e6
+
+    cpuacct_usage = path / "cpuacct.usage"
+    if cpuacct_usage.exists():
+        return int(cpuacct_usage.read_text()) / 1e9
+
+    raise OSError(f"No CPU accounting available for cgroup '{cgroup}'")
+
+
+def read_cgroup_cpu_limit(cgroup: str) -> Optional[float]:
+    """
+    Read the CPU bandwidth limit of a cgroup v2 in cores.
+
+    Args:
+        cgroup: cgroup name or path (see resolve_cgroup)
+
+    Returns:
+        Limit in cores from cpu.max, or None if unlimited or unavailable
+    """
+    cpu_max = resolve_cgroup(cgroup) / "cpu.max"
+    try:
+        quota, period = cpu_max.read_text().split()
+    except (OSError, ValueError):
+        return None
+
+    if quota == "max":
+        return None
+
+    return int(quota) / int(period)
+
+
+def read_pressure(resource: str, cgroup: Optional[str] = None) -> Dict[str, Dict]:
+    """
+    Read pressure stall information (PSI) for a resource.
+
+    Args:
+        resource: 'cpu', 'memory' or 'io'
+        cgroup: Read the cgroup's <resource>.pressure instead of the host's
+
+    Returns:
+        Dictionary with 'some' and (if present) 'full' entries, each mapping
+        avg10, avg60 and avg300 (percent) and total (stalled microseconds)
+    """
+    if resource not in PRESSURE_RESOURCES:
+        raise ValueError(f"Invalid PSI resource '{resource}'")
+
+    if cgroup is not None:
+        path = resolve_cgroup(cgroup) / f"{resource}.pressure"
+    else:
+        path = PRESSURE_ROOT / resource
+
+    pressure: Dict[str, Dict] = {}
+    for line in path.read_text().splitlines():
+        kind, *values = line.split()
+        pressure[kind] = {}
+        for value in values:
+            key, _, number = value.partition("=")
+            pressure[kind][key] = int(number) if key == "total" else float(number)
+
+    return pressure
+
+
+def read_pressure_summary() -> Optional[Dict[str, Dict[str, float]]]:
+    """
+    Read the host's 10 second PSI averages for CPU, memory and I/O.
+
+    Returns:
+        Dictionary mapping resource to some_avg10 and full_avg10 percentages,
+        or None if the kernel does not provide PSI
+    """
+    summary = {}
+    for resource in PRESSURE_RESOURCES:
+        try:
+            pressure = read_pressure(resource)
+        except OSError:
+            continue
+        summary[resource] = {
+            f"{kind}_avg10": values["avg10"] for kind, values in pressure.items()
+        }
+
+    return summary or None
+
+
+class PowercapMeter:
+    """
+    Measures package power from the powercap (RAPL) energy counters.
+
+    Sums all top-level package zones (e.g. intel-rapl:0, intel-rapl:1) and
+    handles counter wraparound at max_energy_range_uj. The platform zone
+    (psys) already includes the packages, and the intel-rapl-mmio zones
+    expose the same package counters again, so neither is counted.
+    """
+
+    def __init__(self, root: Path = POWERCAP_ROOT):
+        """
+        Initialize the meter.
+
+        Args:
+            root: powercap class directory, can point to a fake sysfs tree
+
+        Raises:
+            OSError: If no readable package zone exists
+        """
+        self.root = Path(root)
+        self.zones = self._find_package_zones()
+        if not self.zones:
+            raise OSError(f"No powercap package zones found in {self.root}")
+
+        self.max_ranges = [
+            int((zone / "max_energy_range_uj").read_text()) for zone in self.zones
+        ]
+        self._last_energy = self._read_energy()
+        self._last_time = time.monotonic()
+
+    def _find_package_zones(self) -> List[Path]:
+        """Top-level zones are named <type>:<n>, subzones <type>:<n>:<m>."""
+        if not self.root.is_dir():
+            return []
+
+        zones = []
+        for zone in sorted(self.root.iterdir()):
+            if zone.name.count(":") != 1 or zone.name.startswith("intel-rapl-mmio"):
+                continue
+            try:
+                name = (zone / "name").read_text().strip()
+            except OSError:
+                continue
+            if name.startswith("package-") and (zone / "energy_uj").exists():
+                zones.append(zone)
+        return zones
+
+    def _read_energy(self) -> List[int]:
+        """Read the energy counter of every zone in microjoules."""
+        return [int((zone / "energy_uj").read_text()) for zone in self.zones]
+
+    def read_watts(self) -> Optional[float]:
+        """
+        Get the average package power since the previous call.
+
+        Returns:
+            Power in watts, or None if no time has passed
+        """
+        energy = self._read_energy()
+        now = time.monotonic()
+        elapsed = now - self._last_time
+        if elapsed <= 0:
+            return None
+
+        total_uj = 0
+        for current, last, max_range in zip(energy, self._last_energy, self.max_ranges):
+            delta = current - last
+            if delta < 0:
+                delta += max_range
+            total_uj += delta
+
+        self._last_energy = energy
+        self._last_time = now
+        return total_uj / 1e6 / elapsed
@@ -0,0 +1,406 @@
+"""
+Soak Test Module
+Runs a fixed load configuration for hours and tracks cycle duration jitter,
+achieved load, kernel throughput, temperature and frequency per period, to
+expose slow degradation that short runs never show.
+"""
+
+import argparse
+import json
+import multiprocessing
+import platform
+import sys
+import time
+from datetime import datetime, timezone
+from typing import Any, Callable, Dict, List, Optional, Sequence
+
+from cpu_loader.bench import format_rate
+from cpu_loader.cpu_loader import ComputationType, CPULoader
+from cpu_loader.sensors import read_cpu_frequency, read_cpu_temperature
+
+DEFAULT_OUTPUT = "cpu-loader-soak.json"
+
+# Metrics of a period that are checked for drift
+DRIFT_METRICS = (
+    "achieved_load_percent",
+    "ops_per_sec",
+    "jitter_mean_us",
+    "jitter_p99_us",
+    "temperature_c",
+    "frequency_mhz",
+    "effective_mhz",
+)
+
+
+def jitter_percentile(hist: Sequence[int], percent: float) -> Optional[float]:
+    """
+    Get a cycle jitter percentile from a worker jitter histogram.
+
+    Args:
+        hist: Cycle counts per power-of-two bucket (see get_thread_stats)
+        percent: Percentile (0-100)
+
+    Returns:
+        Upper bound of the bucket holding the percentile in microseconds, or
+        None if the histogram is empty
+    """
+    total = sum(hist)
+    if total == 0:
+        return None
+
+    rank = max(total * percent / 100.0, 1)
+    seen = 0
+    for bucket, count in enumerate(hist):
+        seen += count
+        if seen >= rank:
+            return round(2**bucket / 1e3, 1) if bucket > 0 else 0.0
+
+    return round(2 ** (len(hist) - 1) / 1e3, 1)
+
+
+def summarize_period(
+    before: Dict[int, Dict[str, Any]],
+    after: Dict[int, Dict[str, Any]],
+    elapsed: float,
+) -> Dict[str, Any]:
+    """
+    Summarize the worker statistics between two snapshots.
+
+    Args:
+        before: get_all_stats() at the period start
+        after: get_all_stats() at the period end
+        elapsed: Seconds between the snapshots
+
+    Returns:
+        Dictionary with the mean achieved load from thread CPU time, the
+        aggregate ops/s, the number of cycles, the mean, p50, p99 and
+        maximum bucket of cycle jitter and the effective clock while running
+        (None without a hardware cycle counter)
+    """
+    cpu_ns = user_ns = ops = cycles = jitter_sum = cpu_cycles = 0
+    hist = [0] * len(next(iter(after.values()))["cycle_jitter_hist"])
+    counted = True
+    for thread_id, stats in after.items():
+        previous = before[thread_id]
+        cpu_ns += stats["cpu_time_ns"] - previous["cpu_time_ns"]
+        user_ns += stats["user_time_ns"] - previous["user_time_ns"]
+        ops += stats["ops"] - previous["ops"]
+        cycles += stats["cycles"] - previous["cycles"]
+        jitter_sum += stats["cycle_jitter_sum_ns"] - previous["cycle_jitter_sum_ns"]
+        cpu_cycles += stats["cpu_cycles"] - previous["cpu_cycles"]
+        counted = counted and stats["cycles_counted"]
+        for bucket, count in enumerate(stats["cycle_jitter_hist"]):
+            hist[bucket] += count - previous["cycle_jitter_hist"][bucket]
+
+    max_bucket = max((b for b, count in enumerate(hist) if count), default=None)
+    return {
+        "achieved_load_percent": round(cpu_ns / 1e9 / elapsed / len(after) * 100, 2),
+        "ops_per_sec": round(ops / elapsed, 1),
+        "cycles": cycles,
+        "jitter_mean_us": round(jitter_sum / cycles / 1e3, 2) if cycles else None,
+        "jitter_p50_us": jitter_percentile(hist, 50),
+        "jitter_p99_us": jitter_percentile(hist, 99),
+        "jitter_max_bucket_us": (
+            round(2**max_bucket / 1e3, 1) if max_bucket is not None else None
+        ),
+        # The counters only count user-space cycles
+        "effective_mhz": (
+            round(cpu_cycles / user_ns * 1e3, 1) if counted and user_ns > 0 else None
+        ),
+    }
+
+
+def drift(times: Sequence[float], values: Sequence[Optional[float]]) -> Dict:
+    """
+    Describe how a metric changed over the run.
+
+    Args:
+        times: Seconds since the start of each period
+        values: Metric value of each period, None where not available
+
+    Returns:
+        Dictionary with first, last, min and max value, the change from first
+        to last in percent and the least-squares slope per hour, or an empty
+        dictionary if the metric was never available
+    """
+    points = [(t, v) for t, v in zip(times, values) if v is not None]
+    if not points:
+        return {}
+
+    first = points[0][1]
+    last = points[-1][1]
+    result = {
+        "first": first,
+        "last": last,
+        "min": min(v for _, v in points),
+        "max": max(v for _, v in points),
+        "change_percent": round((last - first) / first * 100, 2) if first else None,
+        "slope_per_hour": None,
+    }
+
+    if len(points) >= 2:
+        mean_t = sum(t for t, _ in points) / len(points)
+        mean_v = sum(v for _, v in points) / len(points)
+        stt = sum((t - mean_t) ** 2 for t, _ in points)
+        stv = sum((t - mean_t) * (v - mean_v) for t, v in points)
+        if stt > 0:
+            result["slope_per_hour"] = round(stv / stt * 3600, 4)
+
+    return result
+
+
+def run_soak(
+    loader: CPULoader,
+    duration: float,
+    interval: float = 60.0,
+    on_period: Optional[Callable[[Dict[str, Any]], None]] = None,
+) -> List[Dict[str, Any]]:
+    """
+    Sample the running loader once per period until the duration is over.
+
+    The soak ends early on KeyboardInterrupt, keeping the periods measured
+    so far.
+
+    Args:
+        loader: CPULoader running the soak configuration
+        duration: Seconds to run
+        interval: Seconds per period
+        on_period: Optional callable receiving each period as it ends
+
+    Returns:
+        List of period summaries with elapsed_s, temperature_c and
+        frequency_mhz in addition to summarize_period()
+    """
+    periods: List[Dict[str, Any]] = []
+    start = time.monotonic()
+    before = loader.get_all_stats()
+    last_time = start
+
+    try:
+        while last_time - start < duration:
+            end = min(last_time + interval, start + duration)
+            time.sleep(max(end - time.monotonic(), 0.0))
+
+            after = loader.get_all_stats()
+            now = time.monotonic()
+            frequency = read_cpu_frequency()
+
+            period = {"elapsed_s": round(now - start, 1)}
+            period.update(summarize_period(before, after, now - last_time))
+            period["temperature_c"] = read_cpu_temperature(max_age=0)
+            period["frequency_mhz"] = (
+                round(frequency / 1e6, 1) if frequency is not None else None
+            )
+
+            periods.append(period)
+            if on_period is not None:
+                on_period(period)
+
+            before = after
+            last_time = now
+    except KeyboardInterrupt:
+        pass
+
+    return periods
+
+
+def build_report(
+    config: Dict[str, Any], periods: Sequence[Dict[str, Any]], started: datetime
+) -> Dict[str, Any]:
+    """
+    Build the final soak report.
+
+    Args:
+        config: Soak configuration
+        periods: Period summaries of run_soak()
+        started: Start time of the soak
+
+    Returns:
+        Dictionary with the configuration, host, periods, the drift of every
+        metric in DRIFT_METRICS and the worst cycle jitter seen
+    """
+    times = [p["elapsed_s"] for p in periods]
+    return {
+        "started": started.isoformat(),
+        "duration_s": times[-1] if times else 0.0,
+        "host": {
+            "platform": platform.platform(),
+            "machine": platform.machine(),
+            "cpus": multiprocessing.cpu_count(),
+        },
+        "config": config,
+        "drift": {
+            metric: drift(times, [p[metric] for p in periods])
+            for metric in DRIFT_METRICS
+        },
+        "worst_jitter_p99_us": max(
+            (p["jitter_p99_us"] for p in periods if p["jitter_p99_us"] is not None),
+            default=None,
+        ),
+        "periods": list(periods),
+    }
+
+
+def format_period(period: Dict[str, Any]) -> str:
+    """Format a period summary as one log line."""
+
+    def cell(key: str, unit: str = "") -> str:
+        value = period[key]
+        return "-" if value is None else f"{value}{unit}"
+
+    return (
+        f"[{period['elapsed_s']:>8.0f} s] load {cell('achieved_load_percent', '%')} "
+        f"ops/s {format_rate(period['ops_per_sec'])} "
+        f"jitter mean {cell('jitter_mean_us', 'us')} "
+        f"p99 {cell('jitter_p99_us', 'us')} max {cell('jitter_max_bucket_us', 'us')} "
+        f"temp {cell('temperature_c', 'C')} freq {cell('frequency_mhz', 'MHz')}"
+    )
+
+
+def format_drift(drifts: Dict[str, Dict]) -> str:
+    """Format the drift of every metric as a fixed-width table."""
+    header = (
+        f"{'metric':<22} {'first':>10} {'last':>10} {'min':>10} {'max':>10} "
+        f"{'change %':>9} {'slope/h':>10}"
+    )
+    lines = [header, "-" * len(header)]
+    for metric, d in drifts.items():
+        if not d:
+            lines.append(f"{metric:<22} {'-':>10}")
+            continue
+        cells = [format_rate(d[k]) for k in ("first", "last", "min", "max")]
+        change = d["change_percent"]
+        lines.append(
+            f"{metric:<22} "
+            + " ".join(f"{v:>10}" for v in cells)
+            + f" {change if change is not None else '-':>9}"
+            + f" {format_rate(d['slope_per_hour']):>10}"
+        )
+    return "\n".join(lines)
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    """Entry point of 'cpu-loader bench soak'."""
+    kernel_names = [
+        ComputationType.to_string(k) for k in sorted(ComputationType.OP_UNITS)
+    ]
+    parser = argparse.ArgumentParser(
+        prog="cpu-loader bench soak",
+        description=(
+            "Run a fixed load for hours and report cycle jitter, load and "
+            "throughput drift and thermal and frequency changes"
+        ),
+        epilog="Ctrl+C ends the soak early and still writes the report.",
+    )
+    parser.add_argument(
+        "--hours", type=float, default=1.0, help="Soak duration (default: 1)"
+    )
+    parser.add_argument(
+        "--interval",
+        type=float,
+        default=60.0,
+        help="Seconds per summary period (default: 60)",
+    )
+    parser.add_argument(
+        "--threads",
+        type=int,
+        default=multiprocessing.cpu_count(),
+        help="Number of threads (default: number of CPUs)",
+    )
+    parser.add_argument(
+        "--load", type=float, default=50.0, help="Load per thread in %% (default: 50)"
+    )
+    parser.add_argument(
+        "--kernel",
+        choices=kernel_names,
+        default="busy-wait",
+        help="Kernel to run (default: busy-wait)",
+    )
+    parser.add_argument(
+        "--cycle-time",
+        type=float,
+        default=10.0,
+        metavar="MS",
+        help="Duty cycle period in ms (default: 10)",
+    )
+    parser.add_argument(
+        "--stagger-phases", action="store_true", help="Stagger worker cycle phases"
+    )
+    parser.add_argument(
+        "--warmup",
+        type=float,
+        default=10.0,
+        help="Warm-up time limit before the soak, 0 disables (default: 10)",
+    )
+    parser.add_argument(
+        "--log", help="Append every period summary as a JSON line to this file"
+    )
+    parser.add_argument(
+        "--output",
+        default=DEFAULT_OUTPUT,
+        help=f"JSON report file, '-' for stdout (default: {DEFAULT_OUTPUT})",
+    )
+    args = parser.parse_args(argv)
+
+    if args.hours <= 0 or args.interval <= 0:
+        parser.error("--hours and --interval must be positive")
+    if args.threads <= 0:
+        parser.error("--threads must be positive")
+
+    config = {
+        "threads": args.threads,
+        "load_percent": args.load,
+        "kernel": args.kernel,
+        "cycle_ms": args.cycle_time,
+        "stagger_phases": args.stagger_phases,
+        "interval_s": args.interval,
+    }
+
+    loader = CPULoader(args.threads)
+    log = open(args.log, "a") if args.log else None
+    try:
+        try:
+            loader.set_cycle_time(args.cycle_time)
+            loader.set_computation_type_from_string(args.kernel)
+            loader.set_phase_stagger(args.stagger_phases)
+            if args.warmup > 0:
+                loader.warmup(max_seconds=args.warmup)
+            loader.set_all_loads(args.load)
+        except ValueError as e:
+            parser.error(str(e))
+
+        # Period summaries go to stderr so that '--output -' keeps stdout JSON
+        def on_period(period):
+            print(format_period(period), file=sys.stderr)
+            if log is not None:
+                log.write(json.dumps(period) + "\n")
+                log.flush()
+
+        started = datetime.now(timezone.utc)
+        periods = run_soak(loader, args.hours * 3600, args.interval, on_period)
+    finally:
+        loader.shutdown()
+        if log is not None:
+            log.close()
+
+    report = build_report(config, periods, started)
+
+    if args.output == "-":
+        json.dump(report, sys.stdout, indent=2)
+        print()
+    else:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    # The table goes to stdout unless stdout carries the JSON
+    table_stream = sys.stderr if args.output == "-" else sys.stdout
+    print(file=table_stream)
+    print(format_drift(report["drift"]), file=table_stream)
+    if args.output != "-":
+        print(f"\nReport written to {args.output}", file=table_stream)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
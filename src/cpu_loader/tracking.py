@@ -0,0 +1,421 @@
+"""
+Load Tracking Benchmark Module
+Applies step, ramp and sine load targets and compares the CPU time the
+worker threads actually consume against the target over time, to quantify
+how faithfully duty cycling follows load requests at different cycle times
+and kernels.
+"""
+
+import argparse
+import json
+import math
+import os
+import sys
+import time
+from typing import Any, Dict, List, Optional, Sequence, Tuple
+
+from cpu_loader.cpu_loader import ComputationType, CPULoader
+from cpu_loader.sensors import read_task_schedstats
+
+PROFILES = ("step", "ramp", "sine")
+DEFAULT_OUTPUT = "cpu-loader-tracking.json"
+
+
+def target_at(
+    profile: str, t: float, duration: float, low: float, high: float, period: float
+) -> float:
+    """
+    Get the load target of a profile at a point in time.
+
+    Args:
+        profile: 'step' (low to high at t = 0), 'ramp' (low to high over the
+                 duration) or 'sine' (between low and high, starting at the
+                 midpoint)
+        t: Seconds since the profile started, negative before the start
+        duration: Length of the profile in seconds
+        low: Lower load in percent
+        high: Upper load in percent
+        period: Period of the sine in seconds
+
+    Returns:
+        Target load in percent
+    """
+    if t < 0:
+        return (low + high) / 2 if profile == "sine" else low
+    if profile == "step":
+        return high
+    if profile == "ramp":
+        return low + (high - low) * min(t / duration, 1.0)
+    if profile == "sine":
+        return (low + high) / 2 + (high - low) / 2 * math.sin(2 * math.pi * t / period)
+    raise ValueError(f"Invalid profile '{profile}'. Available: {', '.join(PROFILES)}")
+
+
+def read_cpu_ns(tids: Sequence[int]) -> List[int]:
+    """Read the CPU time consumed so far by each worker thread."""
+    stats = read_task_schedstats(pid=os.getpid())
+    return [stats[tid][0] for tid in tids]
+
+
+def track(
+    loader: CPULoader,
+    profile: str,
+    duration: float = 3.0,
+    interval: float = 0.05,
+    low: float = 20.0,
+    high: float = 80.0,
+    period: float = 1.0,
+    settle: float = 1.0,
+) -> List[Tuple[float, float, List[float]]]:
+    """
+    Run a load profile on all threads and record target and achieved load.
+
+    The target is updated at the start of each sampling interval and the
+    achieved load of each thread is its CPU time consumed in that interval,
+    read from the scheduler statistics so it does not depend on the worker's
+    own bookkeeping.
+
+    Args:
+        loader: CPULoader whose threads follow the profile
+        profile: Profile name, see target_at()
+        duration: Seconds to run the profile
+        interval: Sampling interval in seconds
+        low: Lower load in percent
+        high: Upper load in percent
+        period: Period of the sine in seconds
+        settle: Seconds to hold the initial target before the profile starts
+
+    Returns:
+        List of (seconds since the profile start at the interval start,
+        target percent, achieved percent per thread)
+    """
+    tids = [stats["tid"] for stats in loader.get_all_stats().values()]
+
+    loader.set_all_loads(target_at(profile, -1.0, duration, low, high, period))
+    time.sleep(settle)
+
+    samples = []
+    start = time.monotonic()
+    tick = start
+    target = target_at(profile, 0.0, duration, low, high, period)
+    loader.set_all_loads(target)
+    last_cpu = read_cpu_ns(tids)
+    last_time = time.monotonic()
+
+    while tick - start < duration:
+        tick += interval
+        time.sleep(max(tick - time.monotonic(), 0.0))
+
+        cpu = read_cpu_ns(tids)
+        now = time.monotonic()
+        achieved = [
+            (c - last) / 1e9 / (now - last_time) * 100.0
+            for c, last in zip(cpu, last_cpu)
+        ]
+        samples.append((last_time - start, target, achieved))
+
+        target = target_at(profile, now - start, duration, low, high, period)
+        loader.set_all_loads(target)
+        last_cpu = cpu
+        last_time = now
+
+    loader.set_all_loads(0.0)
+    return samples
+
+
+def rms_error(samples: Sequence[Tuple[float, float, float]]) -> float:
+    """Root mean square of achieved minus target load in percentage points."""
+    squares = [(achieved - target) ** 2 for _, target, achieved in samples]
+    return round(math.sqrt(sum(squares) / len(squares)), 2)
+
+
+def tracking_metrics(
+    samples: Sequence[Tuple[float, float, float]],
+    profile: str,
+    low: float,
+    high: float,
+    settle_band: float = 5.0,
+) -> Dict[str, Optional[float]]:
+    """
+    Compute tracking quality from (time, target, achieved) samples.
+
+    Args:
+        samples: Samples with time in seconds and loads in percent
+        profile: Profile the samples were recorded with
+        low: Lower load in percent
+        high: Upper load in percent
+        settle_band: Settling band in percent of the step size
+
+    Returns:
+        Dictionary with the RMS, mean and maximum error in percentage points
+        for every profile, and for 'step' the 10-90% rise time, the overshoot
+        in percent of the step size and the time until the load stays within
+        the settling band (None if it never gets there)
+    """
+    errors = [achieved - target for _, target, achieved in samples]
+    metrics: Dict[str, Optional[float]] = {
+        "rms_error": rms_error(samples),
+        "mean_error": round(sum(errors) / len(errors), 2),
+        "max_error": round(max(abs(e) for e in errors), 2),
+        "rise_time_s": None,
+        "overshoot_percent": None,
+        "settling_time_s": None,
+    }
+    if profile != "step":
+        return metrics
+
+    # Achieved load is an interval average, so events are placed at the end
+    # of the interval where they were observed
+    size = high - low
+    ends = [samples[i + 1][0] for i in range(len(samples) - 1)]
+    ends.append(samples[-1][0] + (samples[-1][0] - samples[-2][0]))
+    achieved = [a for _, _, a in samples]
+
+    t10 = next((t for t, a in zip(ends, achieved) if a >= low + 0.1 * size), None)
+    t90 = next((t for t, a in zip(ends, achieved) if a >= low + 0.9 * size), None)
+    if t10 is not None and t90 is not None:
+        metrics["rise_time_s"] = round(t90 - t10, 3)
+
+    metrics["overshoot_percent"] = round(max(max(achieved) - high, 0.0) / size * 100, 1)
+
+    band = settle_band / 100.0 * size
+    outside = [t for t, a in zip(ends, achieved) if abs(a - high) > band]
+    if not outside:
+        metrics["settling_time_s"] = 0.0
+    elif outside[-1] < ends[-1]:
+        metrics["settling_time_s"] = round(outside[-1], 3)
+
+    return metrics
+
+
+def run_tracking(
+    profiles: Sequence[str],
+    kernels: Sequence[int],
+    cycle_times: Sequence[float],
+    num_threads: int = 1,
+    duration: float = 3.0,
+    interval: float = 0.05,
+    low: float = 20.0,
+    high: float = 80.0,
+    period: float = 1.0,
+    settle_band: float = 5.0,
+    progress=None,
+) -> List[Dict[str, Any]]:
+    """
+    Run every profile for every kernel and cycle time.
+
+    Args:
+        profiles: Profiles to run
+        kernels: Computation types to run them with
+        cycle_times: Duty cycle periods in milliseconds
+        num_threads: Threads following the profile
+        duration: Seconds to run each profile
+        interval: Sampling interval in seconds
+        low: Lower load in percent
+        high: Upper load in percent
+        period: Period of the sine in seconds
+        settle_band: Settling band in percent of the step size
+        progress: Optional callable receiving each result as it is measured
+
+    Returns:
+        List of results with profile, kernel, cycle_ms, the metrics of the
+        thread average, the RMS error of every thread and the sampled series
+    """
+    if duration <= 0 or interval <= 0 or interval * 2 > duration:
+        raise ValueError("Duration must cover at least two sampling intervals")
+
+    if not 0 <= low < high <= 100:
+        raise ValueError("Loads must satisfy 0 <= low < high <= 100")
+
+    loader = CPULoader(num_threads)
+    results = []
+    try:
+        for cycle_ms in cycle_times:
+            loader.set_cycle_time(cycle_ms)
+            for kernel in kernels:
+                loader.set_computation_type(kernel)
+                for profile in profiles:
+                    samples = track(
+                        loader, profile, duration, interval, low, high, period
+                    )
+                    average = [(t, target, sum(a) / len(a)) for t, target, a in samples]
+                    per_thread_rms = [
+                        rms_error([(t, target, a[i]) for t, target, a in samples])
+                        for i in range(num_threads)
+                    ]
+
+                    result = {
+                        "profile": profile,
+                        "kernel": ComputationType.to_string(kernel),
+                        "cycle_ms": cycle_ms,
+                        "threads": num_threads,
+                        "metrics": tracking_metrics(
+                            average, profile, low, high, settle_band
+                        ),
+                        "per_thread_rms_error": per_thread_rms,
+                        "series": [
+                            {
+                                "t": round(t, 4),
+                                "target": round(target, 2),
+                                "achieved": [round(v, 2) for v in a],
+                            }
+                            for t, target, a in samples
+                        ],
+                    }
+                    results.append(result)
+                    if progress is not None:
+                        progress(result)
+    finally:
+        loader.shutdown()
+
+    return results
+
+
+def format_tracking_table(results: Sequence[Dict[str, Any]]) -> str:
+    """Format tracking results as one line per profile, kernel and cycle."""
+    header = (
+        f"{'profile':<8} {'kernel':<10} {'cycle ms':>8} {'rise s':>7} "
+        f"{'overshoot %':>11} {'settle s':>8} {'rms':>6} {'mean':>6} {'max':>6}"
+    )
+    lines = [header, "-" * len(header)]
+    for r in results:
+        m = r["metrics"]
+        lines.append(
+            f"{r['profile']:<8} {r['kernel']:<10} {r['cycle_ms']:>8} "
+            f"{_cell(m['rise_time_s']):>7} {_cell(m['overshoot_percent']):>11} "
+            f"{_cell(m['settling_time_s']):>8} {m['rms_error']:>6} "
+            f"{m['mean_error']:>6} {m['max_error']:>6}"
+        )
+    return "\n".join(lines)
+
+
+def _cell(value: Optional[float]) -> str:
+    """Table cell for a metric, '-' if not applicable."""
+    return "-" if value is None else str(value)
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    """Entry point of 'cpu-loader bench tracking'."""
+    kernel_names = [
+        ComputationType.to_string(k) for k in sorted(ComputationType.OP_UNITS)
+    ]
+    parser = argparse.ArgumentParser(
+        prog="cpu-loader bench tracking",
+        description=(
+            "Apply step, ramp and sine load targets and measure how closely "
+            "the threads' CPU time follows them"
+        ),
+        epilog="Errors are in percentage points of load.",
+    )
+    parser.add_argument(
+        "--profiles",
+        nargs="+",
+        choices=PROFILES,
+        default=list(PROFILES),
+        help="Profiles to run (default: all)",
+    )
+    parser.add_argument(
+        "--kernels",
+        nargs="+",
+        choices=kernel_names,
+        default=["busy-wait"],
+        help="Kernels to run (default: busy-wait)",
+    )
+    parser.add_argument(
+        "--cycle-times",
+        nargs="+",
+        type=float,
+        default=[10.0],
+        metavar="MS",
+        help="Duty cycle periods to compare in ms (default: 10)",
+    )
+    parser.add_argument(
+        "--threads", type=int, default=1, help="Threads following the profile"
+    )
+    parser.add_argument(
+        "--duration", type=float, default=3.0, help="Seconds per profile (default: 3)"
+    )
+    parser.add_argument(
+        "--interval",
+        type=float,
+        default=0.05,
+        help="Sampling interval in seconds (default: 0.05)",
+    )
+    parser.add_argument("--low", type=float, default=20.0, help="Lower load %%")
+    parser.add_argument("--high", type=float, default=80.0, help="Upper load %%")
+    parser.add_argument(
+        "--sine-period", type=float, default=1.0, help="Sine period in seconds"
+    )
+    parser.add_argument(
+        "--settle-band",
+        type=float,
+        default=5.0,
+        help="Settling band in percent of the step size (default: 5)",
+    )
+    parser.add_argument(
+        "--output",
+        default=DEFAULT_OUTPUT,
+        help=f"JSON result file, '-' for stdout (default: {DEFAULT_OUTPUT})",
+    )
+    args = parser.parse_args(argv)
+
+    if args.threads <= 0:
+        parser.error("--threads must be positive")
+
+    def progress(result):
+        print(
+            f"{result['profile']:<8} {result['kernel']:<10} "
+            f"{result['cycle_ms']:>6} ms: rms error "
+            f"{result['metrics']['rms_error']}",
+            file=sys.stderr,
+        )
+
+    try:
+        results = run_tracking(
+            args.profiles,
+            [ComputationType.from_string(k) for k in args.kernels],
+            args.cycle_times,
+            args.threads,
+            args.duration,
+            args.interval,
+            args.low,
+            args.high,
+            args.sine_period,
+            args.settle_band,
+            progress,
+        )
+    except ValueError as e:
+        parser.error(str(e))
+
+    report = {
+        "config": {
+            "threads": args.threads,
+            "duration_s": args.duration,
+            "interval_s": args.interval,
+            "low_percent": args.low,
+            "high_percent": args.high,
+            "sine_period_s": args.sine_period,
+            "settle_band_percent": args.settle_band,
+        },
+        "results": results,
+    }
+
+    if args.output == "-":
+        json.dump(report, sys.stdout, indent=2)
+        print()
+    else:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    # The table goes to stdout unless stdout carries the JSON
+    table_stream = sys.stderr if args.output == "-" else sys.stdout
+    print(file=table_stream)
+    print(format_tracking_table(results), file=table_stream)
+    if args.output != "-":
+        print(f"\nResults written to {args.output}", file=table_stream)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,419 @@
+"""
+Victim Workload Module
+Latency-sensitive workloads that run next to the load generator and record
+how long their requests take, turning the loader into a self-contained
+interference benchmark.
+"""
+
+import logging
+import math
+import socket
+import threading
+import time
+from typing import Any, Dict, List, Optional, Sequence, Union
+
+logger = logging.getLogger(__name__)
+
+# Resolution of the latency histogram: 8 buckets per power of two keep the
+# relative error of reported percentiles below 5%
+BUCKETS_PER_OCTAVE = 8
+MAX_OCTAVES = 40  # up to ~1100 seconds in nanoseconds
+
+
+class LatencyHistogram:
+    """
+    Thread-safe histogram of latencies with logarithmic buckets.
+
+    Recording is O(1) and memory is fixed, so the histogram can run for
+    long periods without losing the tail.
+    """
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self.reset()
+
+    def reset(self):
+        """Discard all recorded latencies."""
+        with self._lock:
+            self.counts = [0] * (BUCKETS_PER_OCTAVE * MAX_OCTAVES)
+            self.count = 0
+            self.total_ns = 0
+            self.max_ns = 0
+
+    def record(self, latency_ns: int):
+        """Record one latency in nanoseconds."""
+        latency_ns = max(latency_ns, 1)
+        index = int(math.log2(latency_ns) * BUCKETS_PER_OCTAVE)
+        index = min(index, len(self.counts) - 1)
+        with self._lock:
+            self.counts[index] += 1
+            self.count += 1
+            self.total_ns += latency_ns
+            self.max_ns = max(self.max_ns, latency_ns)
+
+    def percentile(self, percent: float) -> Optional[float]:
+        """
+        Get a latency percentile.
+
+        Args:
+            percent: Percentile (0-100)
+
+        Returns:
+            Latency in nanoseconds at the geometric center of the bucket
+            holding the percentile, or None if nothing was recorded
+        """
+        with self._lock:
+            if self.count == 0:
+                return None
+
+            rank = math.ceil(self.count * percent / 100.0)
+            seen = 0
+            for index, count in enumerate(self.counts):
+                seen += count
+                if seen >= max(rank, 1):
+                    center = 2 ** ((index + 0.5) / BUCKETS_PER_OCTAVE)
+                    return min(center, self.max_ns)
+
+        return float(self.max_ns)
+
+    def summary(self) -> Dict[str, Optional[float]]:
+        """
+        Summarize the recorded latencies.
+
+        Returns:
+            Dictionary with count and mean, p50, p90, p99, p999 and max
+            latencies in microseconds (None if nothing was recorded)
+        """
+        summary: Dict[str, Optional[float]] = {"count": self.count}
+        mean = self.total_ns / self.count if self.count else None
+        values = {
+            "mean_us": mean,
+            "p50_us": self.percentile(50),
+            "p90_us": self.percentile(90),
+            "p99_us": self.percentile(99),
+            "p999_us": self.percentile(99.9),
+            "max_us": self.max_ns if self.count else None,
+        }
+        for key, value in values.items():
+            summary[key] = round(value / 1e3, 1) if value is not None else None
+
+        return summary
+
+
+class Victim:
+    """
+    Base class for victim workloads that issue paced requests from a
+    background thread.
+
+    Requests are scheduled at a fixed rate and latency is measured from the
+    scheduled start, so queueing behind a stalled request counts towards the
+    latency instead of being hidden (no coordinated omission).
+
+    Subclasses implement request(), which performs one request.
+    """
+
+    mode = "none"
+
+    def __init__(self, rate: float = 1000.0, work_us: float = 0.0):
+        """
+        Initialize the victim.
+
+        Args:
+            rate: Requests per second
+            work_us: CPU time each request spends computing, in microseconds
+        """
+        if rate <= 0:
+            raise ValueError("Rate must be positive")
+
+        if work_us < 0:
+            raise ValueError("Work must not be negative")
+
+        self.rate = rate
+        self.work_us = work_us
+        self.histogram = LatencyHistogram()
+        self.errors = 0
+        self.error: Optional[str] = None
+        self._stop_event = threading.Event()
+        self._thread: Optional[threading.Thread] = None
+
+    def start(self):
+        """Start issuing requests in a background thread."""
+        self._stop_event.clear()
+        self.setup()
+        self._thread = threading.Thread(
+            target=self._run, name=f"victim-{self.mode}", daemon=True
+        )
+        self._thread.start()
+
+    def stop(self):
+        """Stop issuing requests and wait for the thread to finish."""
+        self._stop_event.set()
+        if self._thread and self._thread is not threading.current_thread():
+            self._thread.join()
+        self._thread = None
+        self.teardown()
+
+    def is_running(self) -> bool:
+        """Return True while requests are being issued."""
+        return self._thread is not None and self._thread.is_alive()
+
+    def setup(self):
+        """Prepare resources before the first request."""
+
+    def teardown(self):
+        """Release resources after the last request."""
+
+    def request(self):
+        """Perform one request. Implemented by subclasses."""
+        raise NotImplementedError
+
+    def status(self) -> Dict[str, Any]:
+        """Get the victim state and latency summary for reporting."""
+        return {
+            "mode": self.mode,
+            "running": self.is_running(),
+            "rate": self.rate,
+            "work_us": self.work_us,
+            "errors": self.errors,
+            "error": self.error,
+            "latency": self.histogram.summary(),
+        }
+
+    def _spin(self):
+        """Busy-compute for work_us microseconds."""
+        deadline = time.perf_counter_ns() + int(self.work_us * 1e3)
+        while time.perf_counter_ns() < deadline:
+            pass
+
+    def _run(self):
+        """Request loop, runs until stopped or the victim fails."""
+        period_ns = int(1e9 / self.rate)
+        next_start = time.perf_counter_ns()
+
+        while not self._stop_event.is_set():
+            delay = next_start - time.perf_counter_ns()
+            if delay > 0 and self._stop_event.wait(delay / 1e9):
+                break
+
+            try:
+                self.request()
+            except OSError as e:
+                logger.error(f"{self.mode} victim stopped: {e}")
+                self.error = str(e)
+                return
+            except Exception as e:
+                self.errors += 1
+                logger.error(f"Error in {self.mode} victim: {e}")
+            else:
+                self.histogram.record(time.perf_counter_ns() - next_start)
+
+            next_start += period_ns
+
+
+class TaskVictim(Victim):
+    """
+    Timed task loop: every period, compute for work_us and record the time
+    from the scheduled start to completion. Captures wakeup delay, runqueue
+    waits and the slowdown of the work itself.
+    """
+
+    mode = "task"
+
+    def __init__(self, rate: float = 1000.0, work_us: float = 100.0):
+        super().__init__(rate, work_us)
+
+    def request(self):
+        """Run one task."""
+        self._spin()
+
+
+class EchoVictim(Victim):
+    """
+    Request/response over loopback TCP: a paced client sends a payload to a
+    local server thread, which computes for work_us and echoes it back.
+    Captures network stack, wakeup and scheduling latency on both sides.
+    """
+
+    mode = "echo"
+
+    def __init__(
+        self, rate: float = 1000.0, work_us: float = 0.0, payload_bytes: int = 64
+    ):
+        """
+        Initialize the echo victim.
+
+        Args:
+            rate: Requests per second
+            work_us: CPU time the server spends per request, in microseconds
+            payload_bytes: Request and response size
+        """
+        super().__init__(rate, work_us)
+
+        if payload_bytes <= 0:
+            raise ValueError("Payload size must be positive")
+
+        self.payload_bytes = payload_bytes
+        self.payload = b"x" * payload_bytes
+        self.port: Optional[int] = None
+        self._listener: Optional[socket.socket] = None
+        self._client: Optional[socket.socket] = None
+        self._server_thread: Optional[threading.Thread] = None
+
+    def setup(self):
+        """Start the server on an ephemeral loopback port and connect to it."""
+        self._listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self._listener.bind(("127.0.0.1", 0))
+        self._listener.listen(1)
+        self.port = self._listener.getsockname()[1]
+
+        self._server_thread = threading.Thread(
+            target=self._serve, name="victim-echo-server", daemon=True
+        )
+        self._server_thread.start()
+
+        self._client = socket.create_connection(("127.0.0.1", self.port))
+        self._client.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+
+    def teardown(self):
+        """Close the connection and the server."""
+        if self._client is not None:
+            self._client.close()
+            self._client = None
+        if self._listener is not None:
+            self._listener.close()
+            self._listener = None
+        if self._server_thread is not None:
+            self._server_thread.join()
+            self._server_thread = None
+
+    def _recv_exact(self, sock: socket.socket) -> bytes:
+        """Receive one payload, or b'' if the peer closed the connection."""
+        data = b""
+        while len(data) < self.payload_bytes:
+            chunk = sock.recv(self.payload_bytes - len(data))
+            if not chunk:
+                return b""
+            data += chunk
+        return data
+
+    def _serve(self):
+        """Echo payloads on the single client connection until it closes."""
+        try:
+            conn, _ = self._listener.accept()
+        except OSError:
+            return
+
+        with conn:
+            conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            while True:
+                try:
+                    data = self._recv_exact(conn)
+                except OSError:
+                    return
+                if not data:
+                    return
+                self._spin()
+                conn.sendall(data)
+
+    def request(self):
+        """Send one payload and wait for the echo."""
+        self._client.sendall(self.payload)
+        if not self._recv_exact(self._client):
+            raise OSError("Echo server closed the connection")
+
+    def status(self) -> Dict[str, Any]:
+        """Get the victim state and latency summary for reporting."""
+        status = super().status()
+        status.update({"payload_bytes": self.payload_bytes, "port": self.port})
+        return status
+
+
+VICTIMS = {victim.mode: victim for victim in (TaskVictim, EchoVictim)}
+
+
+def create_victim(mode: str, **kwargs) -> Victim:
+    """
+    Create a victim workload by mode name.
+
+    Args:
+        mode: 'task' or 'echo'
+        **kwargs: Arguments of the victim class
+
+    Returns:
+        Victim instance (not started)
+    """
+    if mode not in VICTIMS:
+        available = ", ".join(VICTIMS)
+        raise ValueError(f"Invalid victim mode '{mode}'. Available: {available}")
+
+    return VICTIMS[mode](**kwargs)
+
+
+def run_sweep(
+    loader,
+    victim: Victim,
+    levels: Sequence[float] = (0, 25, 50, 75, 100),
+    duration: float = 5.0,
+    settle: float = 1.0,
+    computation_type: Optional[Union[int, str]] = None,
+) -> List[Dict[str, Any]]:
+    """
+    Measure the victim's latency at a series of load levels.
+
+    Every level is applied to all threads, left to settle, and the victim's
+    histogram is then recorded for the given duration. The previous loads,
+    targets and computation types (also those of groups) are restored
+    afterwards.
+
+    Args:
+        loader: CPULoader instance
+        victim: Running victim workload
+        levels: Load percentages to measure
+        duration: Seconds to record at each level
+        settle: Seconds to wait after changing the load
+        computation_type: Kernel to run during the sweep, defaults to the
+                          current one
+
+    Returns:
+        List of dictionaries with load_percent, computation_type and the
+        latency summary at that level
+    """
+    if loader.controller is not None:
+        raise ValueError("Stop closed-loop control before running a sweep")
+
+    if not victim.is_running():
+        raise ValueError("The victim is not running")
+
+    if duration <= 0 or settle < 0:
+        raise ValueError("Duration must be positive and settle not negative")
+
+    for level in levels:
+        if level < 0 or level > 100:
+            raise ValueError("Load levels must be between 0 and 100")
+
+    previous_loads = loader.save_loads()
+    previous_kernels = loader.save_kernels()
+    if isinstance(computation_type, str):
+        loader.set_computation_type_from_string(computation_type)
+    elif computation_type is not None:
+        loader.set_computation_type(computation_type)
+
+    results = []
+    try:
+        for level in levels:
+            loader.set_all_loads(level)
+            time.sleep(settle)
+            victim.histogram.reset()
+            time.sleep(duration)
+            results.append(
+                {
+                    "load_percent": level,
+                    "computation_type": loader.get_computation_type_string(),
+                    "latency": victim.histogram.summary(),
+                }
+            )
+    finally:
+        loader.restore_kernels(previous_kernels)
+        loader.restore_loads(previous_loads)
+
+    return results
@@ -0,0 +1,72 @@
+"""Tests of the cycles target on hosts without a hardware cycle counter."""
+
+import os
+import subprocess
+import sys
+import textwrap
+
+# The reference frequency is process-wide state of the engine, so every
+# scenario runs in a fresh interpreter with the cycle counter disabled
+PRELUDE = """
+import time
+from cpu_loader import cpu_loader_core, sensors
+from cpu_loader.cpu_loader import CPULoader
+
+assert not cpu_loader_core.has_cycle_counter()
+assert cpu_loader_core.get_reference_frequency() == 0.0
+loader = CPULoader(1)
+"""
+
+
+def run_without_counter(code: str) -> str:
+    env = dict(os.environ, CPU_LOADER_NO_CYCLE_COUNTER="1")
+    env["PYTHONPATH"] = os.pathsep.join(sys.path)
+    result = subprocess.run(
+        [sys.executable, "-c", PRELUDE + textwrap.dedent(code)],
+        env=env,
+        capture_output=True,
+        text=True,
+        timeout=60,
+    )
+    assert result.returncode == 0, result.stderr
+    return result.stdout
+
+
+def test_cycles_target_needs_a_reference_frequency():
+    output = run_without_counter("""
+        sensors.read_reference_frequency = lambda: None
+        for call in (
+            lambda: loader.set_thread_cycles_target(0, 1e9),
+            lambda: loader.set_all_cycles_targets(1e9),
+            lambda: cpu_loader_core.set_thread_cycles_target(0, 1e9),
+        ):
+            try:
+                call()
+            except ValueError:
+                print("refused")
+        # Disabling the target needs no cycles
+        loader.set_thread_cycles_target(0, 0)
+        loader.shutdown()
+        """)
+    assert output.split() == ["refused"] * 3
+
+
+def test_cycles_target_estimates_from_cpu_time():
+    output = run_without_counter("""
+        loader.set_reference_frequency(1e9)
+        loader.set_thread_cycles_target(0, 0.3e9)
+        time.sleep(0.3)
+        before = loader.get_thread_stats(0)
+        start = time.monotonic()
+        time.sleep(1.0)
+        after = loader.get_thread_stats(0)
+        elapsed = time.monotonic() - start
+        loader.shutdown()
+
+        assert not after["cycles_counted"]
+        cpu = (after["cpu_time_ns"] - before["cpu_time_ns"]) / 1e9 / elapsed
+        print(round(cpu, 3))
+        """)
+    # 0.3 G cycles/s at 1 GHz is 30% of a core, not the 100% a thread burns
+    # when its cycles never add up
+    assert 0.15 < float(output) < 0.5
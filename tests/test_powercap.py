@@ -0,0 +1,90 @@
+"""Tests of the powercap (RAPL) meter against a fake sysfs tree."""
+
+import pytest
+
+from cpu_loader import sensors
+
+
+def make_zone(
+    root, name, energy_uj, max_energy_range_uj=1_000_000, zone_name="package-0"
+):
+    zone = root / name
+    zone.mkdir(parents=True)
+    (zone / "name").write_text(f"{zone_name}\n")
+    (zone / "energy_uj").write_text(f"{energy_uj}\n")
+    (zone / "max_energy_range_uj").write_text(f"{max_energy_range_uj}\n")
+    return zone
+
+
+def set_energy(zone, energy_uj):
+    (zone / "energy_uj").write_text(f"{energy_uj}\n")
+
+
+@pytest.fixture
+def clock(monkeypatch):
+    """Replace the meter's monotonic clock with a settable one."""
+    now = [100.0]
+    monkeypatch.setattr(sensors.time, "monotonic", lambda: now[0])
+    return now
+
+
+def test_read_watts_sums_package_zones(tmp_path, clock):
+    package0 = make_zone(tmp_path, "intel-rapl:0", 1_000)
+    package1 = make_zone(tmp_path, "intel-rapl:1", 5_000, zone_name="package-1")
+    # Subzones (cores, dram) are part of their package and must not count twice
+    core = make_zone(tmp_path, "intel-rapl:0:0", 0, zone_name="core")
+
+    meter = sensors.PowercapMeter(tmp_path)
+    assert meter.zones == [package0, package1]
+
+    set_energy(package0, 31_000)
+    set_energy(package1, 15_000)
+    set_energy(core, 500_000)
+    clock[0] += 2.0
+    assert meter.read_watts() == pytest.approx(0.02)
+
+    set_energy(package0, 71_000)
+    clock[0] += 1.0
+    assert meter.read_watts() == pytest.approx(0.04)
+
+
+def test_read_watts_skips_duplicate_zones(tmp_path, clock):
+    package = make_zone(tmp_path, "intel-rapl:0", 0)
+    # The MMIO interface exposes package-0 a second time, psys holds the
+    # whole platform including the package
+    mmio = make_zone(tmp_path, "intel-rapl-mmio:0", 0)
+    psys = make_zone(tmp_path, "intel-rapl:1", 0, zone_name="psys")
+
+    meter = sensors.PowercapMeter(tmp_path)
+    assert meter.zones == [package]
+
+    set_energy(package, 10_000)
+    set_energy(mmio, 10_000)
+    set_energy(psys, 25_000)
+    clock[0] += 1.0
+    assert meter.read_watts() == pytest.approx(0.01)
+
+
+def test_read_watts_handles_counter_wrap(tmp_path, clock):
+    zone = make_zone(tmp_path, "intel-rapl:0", 900_000, max_energy_range_uj=1_000_000)
+    meter = sensors.PowercapMeter(tmp_path)
+
+    set_energy(zone, 100_000)
+    clock[0] += 1.0
+    assert meter.read_watts() == pytest.approx(0.2)
+
+
+def test_read_watts_without_elapsed_time(tmp_path, clock):
+    make_zone(tmp_path, "intel-rapl:0", 0)
+    meter = sensors.PowercapMeter(tmp_path)
+    assert meter.read_watts() is None
+
+
+def test_no_powercap(tmp_path, clock):
+    with pytest.raises(OSError):
+        sensors.PowercapMeter(tmp_path / "missing")
+
+    # A powercap class without package zones, e.g. only a subzone
+    make_zone(tmp_path, "intel-rapl:0:0", 0, zone_name="core")
+    with pytest.raises(OSError):
+        sensors.PowercapMeter(tmp_path)